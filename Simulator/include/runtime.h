@@ -29,7 +29,17 @@ extern "C" {
 
 void fpga_open();
 
-unsigned int _API_CALL fpga_set_irq_callback(unsigned int user_irq_num,char* func);
+// Build the FFT/IFFT plans of length len ahead of the first launch.
+T_DLL void fpga_fft_prewarm(unsigned long long len);
+
+// Length and wall time in ns of the last FFT/IFFT instruction; returns its GFLOP/s,
+// counted as 5 len log2(len) flops.
+T_DLL double fpga_fft_profile(unsigned long long* len, unsigned long long* nsec);
+
+// Number of transform plans held by the plan cache, one per length, direction and kind.
+T_DLL unsigned long long fpga_fft_plan_count();
+
+unsigned int _API_CALL fpga_set_irq_callback(unsigned int user_irq_num,const char* func);
 unsigned int _API_CALL fpga_wait_irq(unsigned int user_irq_num, unsigned int timeout, void** args);
 
 //T_DLL void* TAIBufferAlloc(size_t size);
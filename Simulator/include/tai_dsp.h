@@ -0,0 +1,179 @@
+#ifndef TAI_SIM_TAI_DSP_H
+#define TAI_SIM_TAI_DSP_H
+
+/*
+ * Signal processing helpers shared by the filter and transform instructions
+ */
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "tai_fft.h"
+
+namespace tai {
+
+    struct Pool;
+
+    // Whether a ulen x vlen linear convolution should go through FFTs. taps is the
+    // CONV_FFT_TAPS register: the shorter operand length from which the FFT path is taken,
+    // 0 to let a cost model pick the cutover.
+    bool UseFastConv(uint32_t ulen, uint32_t vlen, uint32_t taps);
+
+    // Overlap-save linear convolution of u and v into out[0, ulen + vlen - 1), the same
+    // layout as the direct loop. Blocks are transformed in Real precision and spread over pool.
+    // Integer outputs are rounded to nearest and wrap like the direct int32 sum.
+    template <typename In, typename Real>
+    void FastConv(FftPlanCache& plans, Pool& pool, const In* u, uint32_t ulen,
+                  const In* v, uint32_t vlen, In* out);
+
+    // Streaming FIR state kept in device memory between launches: a header, the taps, then
+    // the last taps - 1 inputs, oldest first. FIR_STATE_SIZE in runtime_API.h must match.
+    struct FirState {
+        uint32_t taps;
+        uint32_t reserved;
+
+        float* Coef() { return reinterpret_cast<float*>(this + 1); }
+        float* History() { return Coef() + taps; }
+        static size_t Bytes(uint32_t taps) { return sizeof(FirState) + sizeof(float) * (taps ? 2 * size_t(taps) - 1 : 0); }
+    };
+
+    // Load taps and clear the delay line.
+    void FirStateInit(FirState* st, const float* taps, uint32_t n);
+
+    // Filter len samples against the history in st, write len outputs and advance the history.
+    // fft_taps has the meaning of the CONV_FFT_TAPS register. in and out may alias.
+    void FirStream(FftPlanCache& plans, Pool& pool, FirState* st, const float* in, uint32_t len,
+                   float* out, uint32_t fft_taps);
+
+    // Every d-th sample of the full convolution of u and v, (ulen + vlen - 2) / d + 1 of them,
+    // the same as CONV followed by EXTR with X_SIZE = d - 1. Only the kept outputs are computed,
+    // each as one contiguous dot product against the reversed taps; this is a strided direct
+    // form, not a polyphase split of the taps.
+    void FirDecimate(Pool& pool, const float* u, uint32_t ulen, const float* v, uint32_t vlen,
+                     uint32_t d, float* out);
+
+    // Numerically controlled oscillator mixer: out[i] = in[i] * exp(-2 * pi * i * phase_i) with
+    // phase_i = (phase + i * step) / 2^32 cycles. Returns the phase after the last sample so a
+    // stream can be mixed in chunks. The oscillator is rebuilt from the integer accumulator
+    // every NcoBlock samples, so the error does not grow with the stream length.
+    uint32_t NcoMix(Pool& pool, const float* in, uint32_t len, uint32_t phase, uint32_t step,
+                    std::complex<float>* out);
+
+    constexpr uint32_t NcoBlock = 64;
+
+    // 2-D transform of a rows x cols row-major matrix. Rows are transformed in place in out,
+    // then columns are gathered ColumnTile at a time into a contiguous per-thread buffer,
+    // transformed there and scattered back, so no transposed copy of the matrix is made.
+    // Both passes are spread over pool. in and out may alias.
+    void Fft2d(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, std::complex<float>* out,
+               uint32_t rows, uint32_t cols, FftDir dir);
+
+    constexpr uint32_t ColumnTile = 16;
+
+    // n-point transform split as n = n1 * n2 with n1 the largest factor not above sqrt(n).
+    // n1 strided n2-point transforms, a twiddle pass and n2 n1-point transforms, each on
+    // ColumnTile-wide gathered tiles small enough to stay in cache, spread over pool.
+    // Lengths without such a factor use a single plan. in and out may alias.
+    void FourStepFft(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, std::complex<float>* out,
+                     uint32_t n, FftDir dir);
+
+    // Default FFT_LARGE: lengths from which FFT/IFFT take the four-step path. Without worker
+    // threads its extra passes only pay off once a single plan no longer fits in cache.
+    constexpr uint32_t FourStepMin = 1u << 16;
+    constexpr uint32_t FourStepSerialMin = 1u << 22;
+
+    // Forward n-point transform evaluated only at bins (first + i * stride) % n, i < count,
+    // written packed to out. A stride dividing n folds the input to n / stride points; a run of
+    // bins is then taken from one column pass of L-point transforms (L the smallest factor at
+    // least count) and a per-bin combine, skipping the stages that feed other bins. Very sparse
+    // requests are evaluated per bin with the Goertzel recurrence in double precision.
+    void PrunedFft(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, uint32_t n,
+                   uint32_t first, uint32_t stride, uint32_t count, std::complex<float>* out);
+
+    // Chirp-Z transform: out[k] = sum_j in[j] * exp(-2 pi i j (start + k * step) / 2^64) for
+    // k < m, frequencies in 2^-64 cycles per sample. Evaluated as a Bluestein convolution of
+    // the next power of two at least n + m - 1, so the cost follows n and m rather than the
+    // zero-padded length a plain FFT would need for the same spacing.
+    void ChirpZ(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, uint32_t n,
+                uint64_t start, uint64_t step, uint32_t m, std::complex<float>* out);
+
+    // Polyphase channelizer state kept in device memory between launches: a header, the
+    // prototype taps, then the last taps - 1 inputs followed by the fill samples of an
+    // unfinished frame, oldest first. CHAN_STATE_SIZE in runtime_API.h must match.
+    struct ChanState {
+        uint32_t channels;
+        uint32_t taps;
+        uint32_t fill;
+        uint32_t reserved;
+
+        float* Coef() { return reinterpret_cast<float*>(this + 1); }
+        std::complex<float>* History() { return reinterpret_cast<std::complex<float>*>(Coef() + taps); }
+        static size_t Bytes(uint32_t channels, uint32_t taps) {
+            return sizeof(ChanState) + sizeof(float) * taps +
+                   sizeof(std::complex<float>) * (taps && channels ? size_t(taps) + channels - 2 : 0);
+        }
+    };
+
+    // Load the prototype low-pass taps for the given number of channels and clear the history.
+    void ChanStateInit(ChanState* st, const float* taps, uint32_t n, uint32_t channels);
+
+    // Critically sampled analysis filter bank. Every K = channels inputs make one frame of K
+    // outputs, out[f * K + k] = sum_j h[j] x[fK + K - 1 - j] exp(2 pi i k j / K), the signal at
+    // k / K cycles per sample mixed to baseband, filtered by h and decimated by K. Each frame
+    // is K polyphase branch sums and one K-point FFT; frames are spread over pool. Inputs
+    // short of a whole frame wait in st. Returns the number of frames written.
+    uint32_t Channelize(FftPlanCache& plans, Pool& pool, ChanState* st, const std::complex<float>* in,
+                        uint32_t len, std::complex<float>* out);
+
+    // Timing of the last FFT/IFFT, read through fpga_fft_profile. Rates count 5 n log2(n) flops.
+    struct FftProfile {
+        uint64_t len = 0;
+        uint64_t nsec = 0;
+        double gflops = 0;
+
+        void Record(uint64_t n, uint64_t ns);
+    };
+
+    // Spectra for MatchedFilterBank: count templates of tlen samples, stride elements apart,
+    // zero padded to n points, transformed and conjugated into count packed rows of n.
+    void MatchedFilterPrep(FftPlanCache& plans, Pool& pool, const std::complex<float>* tmpl, uint32_t tlen,
+                           uint64_t stride, uint32_t count, uint32_t n, std::complex<float>* spectra);
+
+    // Circular cross-correlation of one n-point block against count templates, row r of out being
+    // IFFT(FFT(in) * spectra row r). The block is transformed once; the products and inverse
+    // transforms of the rows are spread over pool. in may alias out.
+    void MatchedFilterBank(FftPlanCache& plans, Pool& pool, const std::complex<float>* in,
+                           const std::complex<float>* spectra, uint32_t n, uint32_t count,
+                           std::complex<float>* out);
+
+    // Window types of the WINDOW register. Windows are periodic (DFT-even), as used for
+    // spectral analysis.
+    enum class Window : uint32_t {
+        Rect = 0,
+        Hann = 1,
+        Hamming = 2,
+        Blackman = 3,
+        BlackmanHarris = 4,
+    };
+
+    // Window tables by (type, length), generated on first use and kept for the lifetime
+    // of the Accelerator. Rect and unknown types have no table.
+    class WindowCache {
+    public:
+        std::shared_ptr<const std::vector<float>> Get(Window type, uint32_t n);
+
+    private:
+        std::mutex mtx_;
+        std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<const std::vector<float>>> tables_;
+    };
+
+    // Largest |u| * |v| * min(ulen, vlen) for which double precision FFTs still round
+    // every int32 output to its exact value.
+    constexpr double FastConvExactBound = 1099511627776.0;  // 2^40
+
+}  // namespace tai
+
+#endif //TAI_SIM_TAI_DSP_H
@@ -0,0 +1,179 @@
+#ifndef TAI_SIM_TAI_FFT_H
+#define TAI_SIM_TAI_FFT_H
+
+/*
+ * FFT engine behind the FFT/IFFT instructions
+ */
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <complex>
+#include <cstdint>
+
+namespace tai {
+
+    // Largest prime radix handled by the mixed-radix path, anything above goes through Bluestein.
+    constexpr uint32_t FftMaxRadix = 13;
+
+    enum class FftDir {
+        Forward,
+        Inverse,
+    };
+
+    // A plan fixes the length and direction of a transform and holds everything that
+    // does not depend on the data: the digit-reversal permutation, the factorization
+    // into radix-8/4/2 and odd prime stages with their twiddles, or, for lengths with a large
+    // prime factor, the Bluestein chirp and its transformed kernel.
+    // The inverse plan is scaled by 1/n like the IFFT instruction.
+    template <typename T>
+    class FftPlan {
+    public:
+        using Complex = std::complex<T>;
+
+        FftPlan(uint32_t n, FftDir dir);
+        ~FftPlan();
+
+        // out may alias in.
+        void Execute(const Complex* in, Complex* out) const;
+        // Transform of in[i] * window[i]; the window is applied while the input is gathered
+        // for the first butterfly stage, so there is no separate pass for it.
+        void Execute(const Complex* in, Complex* out, const T* window) const;
+
+        uint32_t Size() const { return n_; }
+        FftDir Dir() const { return dir_; }
+        bool Bluestein() const { return bluestein_ != nullptr; }
+
+    private:
+        struct Stage {
+            uint32_t radix;
+            uint32_t span;                  // length of the sub transforms this stage combines
+            std::vector<Complex> tw;        // span * (radix - 1) twiddles
+            std::vector<Complex> roots;     // radix-th roots of unity, generic radix only
+        };
+        struct Chirp;
+
+        void Factorize();
+        void Permute(const Complex* in, Complex* out, const T* window) const;
+        void Butterflies(Complex* data) const;
+        void ExecuteBluestein(const Complex* in, Complex* out, const T* window) const;
+
+        uint32_t n_;
+        FftDir dir_;
+        T scale_;
+        std::vector<uint32_t> perm_;
+        std::vector<Stage> stages_;
+        std::unique_ptr<Chirp> bluestein_;
+    };
+
+    // Transform of n real samples to the n/2+1 non-redundant bins and back. Even lengths
+    // run as an n/2-point complex transform of the interleaved samples followed by one
+    // twiddle pass that splits the even and odd halves, odd lengths fall back to a full
+    // complex transform. Inverse is scaled by 1/n.
+    template <typename T>
+    class RfftPlan {
+    public:
+        using Complex = std::complex<T>;
+
+        explicit RfftPlan(uint32_t n);
+
+        // out holds n/2+1 bins. in and out may alias.
+        void Forward(const T* in, Complex* out) const;
+        // in holds n/2+1 bins, the imaginary parts of bin 0 and of bin n/2 for even n are ignored.
+        void Inverse(const Complex* in, T* out) const;
+
+        uint32_t Size() const { return n_; }
+
+    private:
+        uint32_t n_;
+        std::vector<Complex> tw_;       // exp(-2 * pi * i * k / n), k <= n/4
+        std::unique_ptr<FftPlan<T>> fwd_;
+        std::unique_ptr<FftPlan<T>> inv_;
+    };
+
+    // Radix-2 block floating point transform of interleaved int16 complex data, power-of-two
+    // lengths only. Before each stage the block is scaled down by 2^shift, shift in [0, 2],
+    // so the butterflies cannot overflow. The result times 2^(sum of shifts) approximates the
+    // transform; the inverse also takes log2(n) off that exponent to stand for the 1/n.
+    class FftI16Plan {
+    public:
+        FftI16Plan(uint32_t n, FftDir dir);
+
+        // exps receives the shift of each of the Stages() stages. Returns the block exponent.
+        // out may alias in.
+        int32_t Execute(const int16_t* in, int16_t* out, int32_t* exps) const;
+
+        uint32_t Size() const { return n_; }
+        uint32_t Stages() const { return stages_; }
+        static bool Supported(uint32_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+    private:
+        uint32_t n_;
+        FftDir dir_;
+        uint32_t stages_;
+        std::vector<uint32_t> perm_;
+        std::vector<int16_t> tw_re_;    // per stage of half h, from offset 2 * (h - 1)
+        std::vector<int16_t> tw_im_;
+    };
+
+    // Plans keyed by (length, direction, precision, kind). Plans are immutable once built, so a
+    // single cache per Accelerator is shared by every kernel and worker thread.
+    class FftPlanCache {
+    public:
+        template <typename T>
+        std::shared_ptr<const FftPlan<T>> Get(uint32_t n, FftDir dir) {
+            return Lookup<FftPlan<T>>(Key{n, dir, sizeof(T), false}, n, dir);
+        }
+
+        template <typename T>
+        std::shared_ptr<const RfftPlan<T>> GetReal(uint32_t n) {
+            return Lookup<RfftPlan<T>>(Key{n, FftDir::Forward, sizeof(T), true}, n);
+        }
+
+        std::shared_ptr<const FftI16Plan> GetFixed(uint32_t n, FftDir dir) {
+            return Lookup<FftI16Plan>(Key{n, dir, sizeof(int16_t), false}, n, dir);
+        }
+
+        // Build the single precision forward and inverse plans used by FFT/IFFT.
+        void Prewarm(uint32_t n) {
+            Get<float>(n, FftDir::Forward);
+            Get<float>(n, FftDir::Inverse);
+        }
+
+        size_t Size() {
+            std::lock_guard<std::mutex> lk(mtx_);
+            return plans_.size();
+        }
+
+        void Clear() {
+            std::lock_guard<std::mutex> lk(mtx_);
+            plans_.clear();
+        }
+
+    private:
+        // (length, direction, precision, real input)
+        using Key = std::tuple<uint32_t, FftDir, uint32_t, bool>;
+
+        template <typename Plan, typename... Args>
+        std::shared_ptr<const Plan> Lookup(const Key& key, Args... args) {
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                auto iter = plans_.find(key);
+                if (iter != plans_.end()) return std::static_pointer_cast<const Plan>(iter->second);
+            }
+            // Build outside the lock, long plans must not stall launches of other lengths.
+            auto plan = std::make_shared<const Plan>(args...);
+            std::lock_guard<std::mutex> lk(mtx_);
+            auto iter = plans_.emplace(key, plan).first;
+            return std::static_pointer_cast<const Plan>(iter->second);
+        }
+
+        std::mutex mtx_;
+        std::map<Key, std::shared_ptr<const void>> plans_;
+    };
+
+}  // namespace tai
+
+#endif //TAI_SIM_TAI_FFT_H
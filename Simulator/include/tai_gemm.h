@@ -0,0 +1,29 @@
+#ifndef TAI_SIM_TAI_GEMM_H
+#define TAI_SIM_TAI_GEMM_H
+
+/*
+ * Blocked matrix multiply behind the GEMM instructions
+ */
+
+#include <cstdint>
+
+namespace tai {
+
+    struct Pool;
+
+    // c = a b for row-major a (m x k), b (k x n) and c (m x n), the GEMM.* layout with
+    // X_SIZE = m, Y_SIZE = k and Z_SIZE = n. b is packed kc x nc at a time into panels nr
+    // columns wide shared by all threads, a mc x kc at a time into panels mr rows tall per
+    // thread, and the mr x nr register block of Simd() runs over pairs of panels. kc, mc and nc
+    // follow the host L1, L2 and L3 sizes. Up to threads threads of pool take mc x nc macro-tiles
+    // of c. Every element of c is summed in the same order whatever the thread count; int32 wraps.
+    void Gemm(Pool& pool, uint32_t threads, const float* a, const float* b, float* c,
+              uint32_t m, uint32_t k, uint32_t n);
+    void Gemm(Pool& pool, uint32_t threads, const double* a, const double* b, double* c,
+              uint32_t m, uint32_t k, uint32_t n);
+    void Gemm(Pool& pool, uint32_t threads, const int32_t* a, const int32_t* b, int32_t* c,
+              uint32_t m, uint32_t k, uint32_t n);
+
+}  // namespace tai
+
+#endif //TAI_SIM_TAI_GEMM_H
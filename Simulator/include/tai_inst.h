@@ -66,6 +66,14 @@ namespace tai {
         int path_ = 0;
         Drive driver_;
         Drive driven_;
+
+        // Elementwise instructions can also run on elements [first, first + n) alone, reading
+        // rs0 from src and writing rd to dst, with scratch room for one tile of a gathered rs1.
+        // Program::Build fuses Drive::Data chains made only of such instructions into one pass
+        // over tiles.
+        std::function<void(Unit*, void* dst, const void* src, uint64_t first, uint32_t n, void* scratch)> tile_;
+        uint32_t in_bytes_ = 0;
+        uint32_t out_bytes_ = 0;
     };
 
     struct Program {
@@ -131,6 +139,8 @@ namespace tai {
         Instruction *VaddI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction *VaddF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction *VaddF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VaddC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VaddC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction *VaddiI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, int32_t imm);
         Instruction *VaddiF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float imm);    
         Instruction *VaddiF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm);
@@ -148,6 +158,7 @@ namespace tai {
         Instruction *VmulF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction *VmulF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction *VmulC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VmulC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction *VmuliI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, int32_t imm);
         Instruction *VmuliF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float imm);    
         Instruction *VmuliF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm);
@@ -202,6 +213,33 @@ namespace tai {
         Instruction *VminI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
         Instruction *VminF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
         Instruction *VminF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // sum, max, min along REDUCE_AXIS (ndim, xsize, ysize, zsize)
+        Instruction *VsumAxisI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VsumAxisF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VsumAxisF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VmaxAxisI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VmaxAxisF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VmaxAxisF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VminAxisI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VminAxisF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VminAxisF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // sum, max, min over segments (segments), rs1 holding segments + 1 offsets
+        Instruction *VsumSegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VsumSegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VsumSegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VmaxSegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VmaxSegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VmaxSegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VminSegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VminSegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction *VminSegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        // argmax, argmin (vlen): rd gets the value and the index of its first occurrence
+        Instruction *VargmaxI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VargmaxF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VargmaxF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VargminI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VargminF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction *VargminF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
 
         // transpose (ndim, xsize, ysize, zsize)
         Instruction *TransposeI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
@@ -234,9 +272,44 @@ namespace tai {
         // length of u: ULEN, length of v: VLEN
         Instruction* Conv(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
         Instruction* Fir(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
-        // length of vector: VLEN
+        // Streaming FIR: FIR.INIT loads VLEN taps into the state at rd, FIR.STREAM filters
+        // VLEN samples through the state at rs1, carrying the delay line to the next launch
+        Instruction* FirInit(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction* FirStream(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        // Polyphase channelizer: CHAN.INIT loads VLEN prototype taps for CHANNELS channels into
+        // the state at rd; CHAN splits VLEN complex samples at rs0 with the state at rs1 into
+        // frames of CHANNELS outputs at rd and leaves the frame count in CHAN_FRAMES
+        Instruction* ChanInit(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction* Chan(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        // Float CONV of ULEN and VLEN decimated by X_SIZE + 1, as CONV then EXTR in one pass
+        Instruction* FirDecim(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        // length of vector: VLEN, from FFT_LARGE points on as a multithreaded four-step transform
         Instruction* Fft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
         Instruction* Ifft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // BIN_COUNT bins of the VLEN-point FFT, from BIN_FIRST every BIN_STRIDE, packed
+        Instruction* FftPrune(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // Chirp-Z transform of VLEN samples at CZT_POINTS frequencies from CZT_START, CZT_STEP apart
+        Instruction* Czt(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // FFT of the input weighted by the WINDOW table, applied while loading the first stage
+        Instruction* FftWin(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // VLEN real samples to VLEN/2+1 complex bins and back
+        Instruction* Rfft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction* Irfft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // Block floating point VLEN-point transforms of int16 complex data, the shift of every
+        // stage goes to the int32 array at rs1 and their sum to BFP_EXP
+        Instruction* FftI16(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        Instruction* IfftI16(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        // 2-D transforms of an X_SIZE x Y_SIZE row-major matrix
+        Instruction* Fft2d(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction* Ifft2d(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        // Matched filter bank. MF.PREP turns BATCH templates of ULEN samples, ROW_STRIDE apart,
+        // into conjugated VLEN-point spectra; MF.BANK correlates the VLEN block at rs0 with
+        // the BATCH spectra at rs1 into BATCH rows of VLEN
+        Instruction* MfPrep(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction* MfBank(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1);
+        // VLEN-point transforms of BATCH rows, ROW_STRIDE elements apart
+        Instruction* FftBatch(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
+        Instruction* IfftBatch(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
         Instruction* Ddc(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
         Instruction* Extr(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs);
 
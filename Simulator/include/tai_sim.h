@@ -9,12 +9,15 @@
 #include <set>
 #include <queue>
 #include <mutex>
+#include <atomic>
 #include <thread>
 #include <cstdint>
 #include <functional>
 #include <condition_variable>
 #include "tai_inst.h"
 #include "tai_spec.h"
+#include "tai_fft.h"
+#include "tai_dsp.h"
 
 namespace tai {
 
@@ -48,6 +51,8 @@ namespace tai {
 
         uint8_t* Get() { return data; }
 
+        uint32_t Size() const { return nbytes; }
+
         void* Alloc(size_t nbytes) { return reinterpret_cast<void*>(data + CMA::Alloc(nbytes)); }
 
         void Free(void* ptr) {
@@ -174,6 +179,34 @@ namespace tai {
         std::shared_ptr<Sync> sync_;
     };
 
+    // Worker threads for kernels that split their work into independent tasks.
+    // The calling unit drains tasks as well, so a pool of size 0 runs everything inline.
+    // The Accelerator's pool has TAI_WORKERS workers when that is set in the environment.
+    struct Pool {
+        explicit Pool(uint32_t workers);
+        ~Pool();
+
+        // Run fn(i) for every i in [0, n) and return when all of them are done.
+        void ParallelFor(uint32_t n, const std::function<void(uint32_t)>& fn);
+        // Number of threads taking part in a ParallelFor, the caller included.
+        uint32_t Size() const { return static_cast<uint32_t>(workers_.size()) + 1; }
+
+    private:
+        void Drain();
+
+        std::vector<std::thread> workers_;
+        std::mutex call_mtx_;
+        std::mutex mtx_;
+        std::condition_variable cond_;
+        std::condition_variable done_cond_;
+        const std::function<void(uint32_t)>* job_ = nullptr;
+        uint32_t total_ = 0;
+        std::atomic<uint32_t> next_{0};
+        uint32_t active_ = 0;
+        uint64_t generation_ = 0;
+        bool shutdown_ = false;
+    };
+
     struct Path {
         Path(): sync_(std::make_shared<Sync>()) {}
         void insert(Instruction *i) {
@@ -220,6 +253,10 @@ namespace tai {
         MPU mpu_;
         LSU lsu_;
         std::vector<Path> paths;
+        FftPlanCache fft_plans_;
+        WindowCache windows_;
+        FftProfile fft_profile_;
+        Pool pool_;
     };
 
 }  // namespace tai
@@ -0,0 +1,67 @@
+#ifndef TAI_SIM_TAI_SIMD_H
+#define TAI_SIM_TAI_SIMD_H
+
+/*
+ * Vector kernels with runtime CPU dispatch
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tai {
+
+    // Kernels for the vector instructions. Complex data is interleaved (re, im) like
+    // float _Complex / double _Complex, n counts complex elements. Outputs may alias inputs.
+    // Results depend on the level chosen: the AVX2 and AVX-512 products are fused
+    // multiply-adds, so a component of a * b may differ from the plain C++ kernel by up to
+    // eps |a| |b|, which can be the whole value when re and im terms cancel. Double |z| is
+    // sqrt(re^2 + im^2) from the SSE3 level on, within 1 ulp of hypot but not bit-identical.
+    // Subtraction, conjugation and float |z| are the same on every level.
+    struct SimdKernels {
+        const char* isa;
+
+        void (*mul_c32)(const float* a, const float* b, float* out, size_t n);
+        void (*muli_c32)(const float* a, float re, float im, float* out, size_t n);
+        void (*sub_c32)(const float* a, const float* b, float* out, size_t n);
+        void (*conj_c32)(const float* a, float* out, size_t n);
+        void (*abs_c32)(const float* a, float* out, size_t n);
+
+        void (*mul_c64)(const double* a, const double* b, double* out, size_t n);
+        void (*muli_c64)(const double* a, double re, double im, double* out, size_t n);
+        void (*sub_c64)(const double* a, const double* b, double* out, size_t n);
+        void (*conj_c64)(const double* a, double* out, size_t n);
+        void (*abs_c64)(const double* a, double* out, size_t n);
+
+        // One radix-2 stage of the int16 block floating point FFT on n interleaved complex values:
+        // (x[j], x[j + half]) in every group of 2 * half, with the Q15 twiddle of k = j % half
+        // stored as (wr, wr) in tw_re and (-wi, wi) in tw_im. Inputs are first divided by
+        // 2^shift with rounding. Returns the largest |component| of the result.
+        uint32_t (*fft_stage_i16)(int16_t* x, uint32_t n, uint32_t half, const int16_t* tw_re,
+                                  const int16_t* tw_im, int shift);
+
+        // exp and log10 by polynomials instead of libm: within 2 ULP, or with fast set about
+        // 4e-6 (float) and 5e-9 (double) relative. Special values follow libm.
+        void (*exp_f32)(const float* a, float* out, size_t n, bool fast);
+        void (*exp_f64)(const double* a, double* out, size_t n, bool fast);
+        void (*log10_f32)(const float* a, float* out, size_t n, bool fast);
+        void (*log10_f64)(const double* a, double* out, size_t n, bool fast);
+
+        // GEMM register block of mr x nr elements: c[i * ldc + j] = sum_l a[l * mr + i] * b[l * nr + j],
+        // plus the old c[i * ldc + j] with accumulate set, a and b being packed panels of depth k.
+        template <typename T>
+        struct Gemm {
+            void (*run)(size_t k, const T* a, const T* b, T* c, size_t ldc, bool accumulate);
+            uint32_t mr, nr;
+        };
+        Gemm<float> gemm_f32;
+        Gemm<double> gemm_f64;
+        Gemm<int32_t> gemm_i32;
+    };
+
+    // The widest kernel set the host supports (AVX-512, AVX2+FMA, SSE3 or plain C++),
+    // chosen from CPUID on first use. The int16 FFT stage uses AVX2 on the AVX-512 level too.
+    const SimdKernels& Simd();
+
+}  // namespace tai
+
+#endif //TAI_SIM_TAI_SIMD_H
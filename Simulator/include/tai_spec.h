@@ -101,6 +101,41 @@ namespace tai {
         ACCUM_OFFSET,
         CONST_OFFSET,
         INPUT_OFFSET,
+        // For batched FFT
+        BATCH,                          // Number of rows
+        ROW_STRIDE,                     // Elements between row starts, 0 for packed rows
+        CONV_FFT_TAPS,                  // CONV/FIR: shorter operand length from which FFTs are used, 0 for auto
+        // For DDC
+        NCO_STEP,                       // Phase increment per sample, in 2^-32 cycles
+        NCO_PHASE,                      // Phase accumulator, carried from one DDC to the next
+        BFP_EXP,                        // Block exponent of the last FFT.I16/IFFT.I16, signed
+        WINDOW,                         // FFT.WIN window: 0 rect, 1 Hann, 2 Hamming, 3 Blackman, 4 Blackman-Harris
+        FFT_LARGE,                      // FFT/IFFT length from which the four-step path is used, 0 for auto
+        // For FFT.PRUNE
+        BIN_FIRST,                      // First output bin
+        BIN_STRIDE,                     // Bins between outputs, 0 for 1
+        BIN_COUNT,                      // Number of output bins
+        // For CZT
+        CZT_START,                      // First frequency, in 2^-64 cycles per sample
+        CZT_STEP,                       // Frequency spacing, in 2^-64 cycles per sample
+        CZT_POINTS,                     // Number of output points
+        // For CHAN
+        CHANNELS,                       // Channels of the polyphase filter bank, also the decimation
+        CHAN_FRAMES,                    // Frames of CHANNELS outputs written by the last CHAN
+        // For vector instructions
+        VEC_THREADS,                    // Threads for one vector instruction, 0 for the whole pool
+        VEC_PAR_MIN,                    // VLEN from which vector instructions are split over threads, 0 for auto
+        MATH_MODE,                      // VEXP/VLOG10 .F32/.F64: 0 libm, 1 polynomial within 2 ULP, 2 fast polynomial
+        // For axis and segmented reductions
+        REDUCE_AXIS,                    // Axis reduced by V*.AXIS: 0 x, 1 y, 2 z
+        SEGMENTS,                       // Number of segments of V*.SEG
+        // Operand layouts of the elementwise V* instructions and VSUM/VMAX/VMIN/VARG*
+        VD_STRIDE,                      // Elements between results, 0 for 1
+        VS0_STRIDE,                     // Elements between first operands, 0 for 1
+        VS1_STRIDE,                     // Elements between second operands, 0 for 1
+        VD_INDEX,                       // Address of VLEN uint32 result indices, 0 to use VD_STRIDE
+        VS0_INDEX,                      // Address of VLEN uint32 first operand indices, 0 to use VS0_STRIDE
+        VS1_INDEX,                      // Address of VLEN uint32 second operand indices, 0 to use VS1_STRIDE
     };
 
     enum OutputPorts {
@@ -0,0 +1,365 @@
+#ifndef TAI_SIM_TAI_VEC_H
+#define TAI_SIM_TAI_VEC_H
+
+/*
+ * Typed elementwise and reduction kernels behind the V* instructions
+ */
+
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "tai_simd.h"
+
+namespace tai {
+namespace vec {
+
+    // Operations, applied per element. Results are converted to the output element type,
+    // so e.g. Rec of int32 is taken in double and Abs of a complex type gives its magnitude.
+    struct Add { template <typename T> T operator()(T a, T b) const { return a + b; } };
+    struct Sub { template <typename T> T operator()(T a, T b) const { return a - b; } };
+    struct Mul { template <typename T> T operator()(T a, T b) const { return a * b; } };
+
+    struct Abs { template <typename T> auto operator()(T a) const { return std::abs(a); } };
+    struct Squa { template <typename T> T operator()(T a) const { return a * a; } };
+    struct Neg { template <typename T> T operator()(T a) const { return -a; } };
+    struct Exp { template <typename T> auto operator()(T a) const { return std::exp(a); } };
+    struct Log10 { template <typename T> auto operator()(T a) const { return std::log10(a); } };
+    struct Conj { template <typename T> T operator()(T a) const { return std::conj(a); } };
+    struct Rec {
+        template <typename T> auto operator()(T a) const {
+            using R = typename std::conditional<std::is_integral<T>::value, double, T>::type;
+            return R(1) / a;
+        }
+    };
+
+    // Binary operation with an immediate second operand.
+    template <typename Op, typename T>
+    struct WithImm {
+        T imm;
+        T operator()(T a) const { return Op()(a, imm); }
+    };
+
+    // Prefer(b, a): b replaces a. A NaN never replaces and is never replaced.
+    struct Max {
+        template <typename T> static bool Prefer(T b, T a) { return b > a; }
+        template <typename T> T operator()(T a, T b) const { return Prefer(b, a) ? b : a; }
+    };
+    struct Min {
+        template <typename T> static bool Prefer(T b, T a) { return b < a; }
+        template <typename T> T operator()(T a, T b) const { return Prefer(b, a) ? b : a; }
+    };
+
+    // Pointers at this alignment get their loops compiled without peeling.
+    constexpr size_t Align = 64;
+
+    namespace detail {
+        inline bool Aligned(const void* p) { return reinterpret_cast<uintptr_t>(p) % Align == 0; }
+
+        inline bool Disjoint(const void* a, size_t abytes, const void* b, size_t bbytes) {
+            auto x = reinterpret_cast<uintptr_t>(a), y = reinterpret_cast<uintptr_t>(b);
+            return x + abytes <= y || y + bbytes <= x;
+        }
+
+        template <bool A, typename T>
+        T* Assume(T* p) {
+            return A ? static_cast<T*>(__builtin_assume_aligned(p, Align)) : p;
+        }
+
+        template <bool A, typename Out, typename In, typename Op>
+        void Map1(Out* __restrict out, const In* __restrict a, size_t n, Op op) {
+            out = Assume<A>(out);
+            a = Assume<A>(a);
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = Out(op(a[i]));
+            }
+        }
+
+        template <bool A, typename Out, typename In, typename Op>
+        void Map2(Out* __restrict out, const In* __restrict a, const In* __restrict b, size_t n, Op op) {
+            out = Assume<A>(out);
+            a = Assume<A>(a);
+            b = Assume<A>(b);
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = Out(op(a[i], b[i]));
+            }
+        }
+
+        // Same-index in-place updates have no loop-carried dependence either.
+        template <typename Out, typename In, typename Op>
+        void Map1Alias(Out* out, const In* a, size_t n, Op op) {
+            #pragma GCC ivdep
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = Out(op(a[i]));
+            }
+        }
+
+        template <typename Out, typename In, typename Op>
+        void Map2Alias(Out* out, const In* a, const In* b, size_t n, Op op) {
+            #pragma GCC ivdep
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = Out(op(a[i], b[i]));
+            }
+        }
+
+        // out either is in (same elements, same size) or does not overlap it.
+        template <typename Out, typename In>
+        bool Separate(const Out* out, const In* in, size_t n) {
+            return (sizeof(Out) == sizeof(In) && static_cast<const void*>(out) == in) ||
+                   Disjoint(out, n * sizeof(Out), in, n * sizeof(In));
+        }
+
+        template <typename Out, typename In>
+        bool Restrict(const Out* out, const In* in, size_t n) {
+            return Disjoint(out, n * sizeof(Out), in, n * sizeof(In));
+        }
+    }  // namespace detail
+
+    // out[i] = op(a[i]) for i < n. out may alias a.
+    template <typename Out, typename In, typename Op>
+    void Map(Out* out, const In* a, size_t n, Op op) {
+        if (detail::Restrict(out, a, n)) {
+            if (detail::Aligned(out) && detail::Aligned(a)) {
+                detail::Map1<true>(out, a, n, op);
+            } else {
+                detail::Map1<false>(out, a, n, op);
+            }
+        } else if (detail::Separate(out, a, n)) {
+            detail::Map1Alias(out, a, n, op);
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = Out(op(a[i]));
+            }
+        }
+    }
+
+    // out[i] = op(a[i], b[i]) for i < n. out may alias a or b.
+    template <typename Out, typename In, typename Op>
+    void Map(Out* out, const In* a, const In* b, size_t n, Op op) {
+        if (detail::Restrict(out, a, n) && detail::Restrict(out, b, n)) {
+            if (detail::Aligned(out) && detail::Aligned(a) && detail::Aligned(b)) {
+                detail::Map2<true>(out, a, b, n, op);
+            } else {
+                detail::Map2<false>(out, a, b, n, op);
+            }
+        } else if (detail::Separate(out, a, n) && detail::Separate(out, b, n)) {
+            detail::Map2Alias(out, a, b, n, op);
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = Out(op(a[i], b[i]));
+            }
+        }
+    }
+
+    // Where the elements of a vector operand are: element i at base[i * stride], or at
+    // base[index[i]] when there is an index array.
+    struct Layout {
+        uint64_t stride = 1;
+        const uint32_t* index = nullptr;
+
+        bool Packed() const { return index == nullptr && stride == 1; }
+        uint64_t At(uint64_t i) const { return index ? index[i] : i * stride; }
+    };
+
+    // Elements ahead of the current one that Gather and Scatter prefetch.
+    constexpr uint32_t PrefetchAhead = 16;
+
+    namespace detail {
+        struct Bytes16 { uint64_t lo, hi; };
+
+        template <typename E>
+        void Gather(const E* base, Layout l, uint64_t first, uint32_t n, E* tile) {
+            if (l.index) {
+                const uint32_t* idx = l.index + first;
+                for (uint32_t i = 0; i < n; ++i) {
+                    if (i + PrefetchAhead < n) __builtin_prefetch(base + idx[i + PrefetchAhead]);
+                    tile[i] = base[idx[i]];
+                }
+            } else {
+                const E* p = base + first * l.stride;
+                for (uint32_t i = 0; i < n; ++i) {
+                    if (i + PrefetchAhead < n) __builtin_prefetch(p + (i + PrefetchAhead) * l.stride);
+                    tile[i] = p[i * l.stride];
+                }
+            }
+        }
+
+        template <typename E>
+        void Scatter(const E* tile, Layout l, uint64_t first, uint32_t n, E* base) {
+            if (l.index) {
+                const uint32_t* idx = l.index + first;
+                for (uint32_t i = 0; i < n; ++i) {
+                    if (i + PrefetchAhead < n) __builtin_prefetch(base + idx[i + PrefetchAhead], 1);
+                    base[idx[i]] = tile[i];
+                }
+            } else {
+                E* p = base + first * l.stride;
+                for (uint32_t i = 0; i < n; ++i) {
+                    if (i + PrefetchAhead < n) __builtin_prefetch(p + (i + PrefetchAhead) * l.stride, 1);
+                    p[i * l.stride] = tile[i];
+                }
+            }
+        }
+    }  // namespace detail
+
+    // Elements [first, first + n) of the operand at base, of the given size, packed into tile.
+    inline void Gather(const void* base, size_t bytes, Layout l, uint64_t first, uint32_t n, void* tile) {
+        switch (bytes) {
+            case 4: detail::Gather(static_cast<const uint32_t*>(base), l, first, n, static_cast<uint32_t*>(tile)); break;
+            case 8: detail::Gather(static_cast<const uint64_t*>(base), l, first, n, static_cast<uint64_t*>(tile)); break;
+            case 16: detail::Gather(static_cast<const detail::Bytes16*>(base), l, first, n, static_cast<detail::Bytes16*>(tile)); break;
+        }
+    }
+
+    // The inverse of Gather. With an index array, repeated indices of one tile keep the last
+    // element; repeats across tiles split over threads are unordered.
+    inline void Scatter(const void* tile, size_t bytes, Layout l, uint64_t first, uint32_t n, void* base) {
+        switch (bytes) {
+            case 4: detail::Scatter(static_cast<const uint32_t*>(tile), l, first, n, static_cast<uint32_t*>(base)); break;
+            case 8: detail::Scatter(static_cast<const uint64_t*>(tile), l, first, n, static_cast<uint64_t*>(base)); break;
+            case 16: detail::Scatter(static_cast<const detail::Bytes16*>(tile), l, first, n, static_cast<detail::Bytes16*>(base)); break;
+        }
+    }
+
+    // Complex operations the generic loop would leave to libgcc go to the SIMD kernels.
+    using C32 = std::complex<float>;
+    using C64 = std::complex<double>;
+
+    inline const float* F(const C32* p) { return reinterpret_cast<const float*>(p); }
+    inline float* F(C32* p) { return reinterpret_cast<float*>(p); }
+    inline const double* F(const C64* p) { return reinterpret_cast<const double*>(p); }
+    inline double* F(C64* p) { return reinterpret_cast<double*>(p); }
+
+    inline void Map(C32* out, const C32* a, const C32* b, size_t n, Mul) { Simd().mul_c32(F(a), F(b), F(out), n); }
+    inline void Map(C64* out, const C64* a, const C64* b, size_t n, Mul) { Simd().mul_c64(F(a), F(b), F(out), n); }
+    inline void Map(C32* out, const C32* a, const C32* b, size_t n, Sub) { Simd().sub_c32(F(a), F(b), F(out), n); }
+    inline void Map(C64* out, const C64* a, const C64* b, size_t n, Sub) { Simd().sub_c64(F(a), F(b), F(out), n); }
+    inline void Map(C32* out, const C32* a, size_t n, Conj) { Simd().conj_c32(F(a), F(out), n); }
+    inline void Map(C64* out, const C64* a, size_t n, Conj) { Simd().conj_c64(F(a), F(out), n); }
+    inline void Map(float* out, const C32* a, size_t n, Abs) { Simd().abs_c32(F(a), out, n); }
+    inline void Map(double* out, const C64* a, size_t n, Abs) { Simd().abs_c64(F(a), out, n); }
+    inline void Map(C32* out, const C32* a, size_t n, WithImm<Mul, C32> op) {
+        Simd().muli_c32(F(a), op.imm.real(), op.imm.imag(), F(out), n);
+    }
+    inline void Map(C64* out, const C64* a, size_t n, WithImm<Mul, C64> op) {
+        Simd().muli_c64(F(a), op.imm.real(), op.imm.imag(), F(out), n);
+    }
+
+    // MATH_MODE settings of the float exp and log10 instructions.
+    enum class MathMode : uint32_t {
+        Libm = 0,
+        Precise = 1,
+        Fast = 2,
+    };
+
+    // exp and log10 through the polynomial SIMD kernels.
+    struct ExpPoly { bool fast; };
+    struct Log10Poly { bool fast; };
+
+    inline void Map(float* out, const float* a, size_t n, ExpPoly op) { Simd().exp_f32(a, out, n, op.fast); }
+    inline void Map(double* out, const double* a, size_t n, ExpPoly op) { Simd().exp_f64(a, out, n, op.fast); }
+    inline void Map(float* out, const float* a, size_t n, Log10Poly op) { Simd().log10_f32(a, out, n, op.fast); }
+    inline void Map(double* out, const double* a, size_t n, Log10Poly op) { Simd().log10_f64(a, out, n, op.fast); }
+
+    // VLOG10.F32 widens its float results to double, a block at a time.
+    inline void Map(double* out, const float* a, size_t n, Log10Poly op) {
+        float block[256];
+        for (size_t i = 0; i < n; i += 256) {
+            size_t m = std::min<size_t>(256, n - i);
+            Simd().log10_f32(a + i, block, m, op.fast);
+            for (size_t j = 0; j < m; ++j) {
+                out[i + j] = block[j];
+            }
+        }
+    }
+
+    // Reductions keep ReduceLanes independent partial results over blocks of at most
+    // ReduceBlock elements, and blocks are combined pairwise. The rounding error of a sum
+    // grows with log n, and the order of the operations depends on n alone.
+    constexpr size_t ReduceLanes = 16;
+    constexpr size_t ReduceBlock = 256;
+
+    // p[0, n) combined pairwise into p[0].
+    template <typename T, typename Op>
+    T Tree(T* p, size_t n, Op op) {
+        for (size_t w = 1; w < n; w *= 2) {
+            for (size_t i = 0; i + w < n; i += 2 * w) {
+                p[i] = op(p[i], p[i + w]);
+            }
+        }
+        return p[0];
+    }
+
+    // Reduction of a[0, n) with op. init seeds every lane, so it must be the identity of op
+    // or, for Max and Min, an element of a.
+    template <typename T, typename Op>
+    T Fold(const T* a, size_t n, T init, Op op) {
+        if (n > ReduceBlock) {
+            size_t half = (n / 2 + ReduceBlock - 1) / ReduceBlock * ReduceBlock;
+            return op(Fold(a, half, init, op), Fold(a + half, n - half, init, op));
+        }
+        T acc[ReduceLanes];
+        std::fill(acc, acc + ReduceLanes, init);
+        size_t i = 0;
+        for (; i + ReduceLanes <= n; i += ReduceLanes) {
+            for (size_t j = 0; j < ReduceLanes; ++j) {
+                acc[j] = op(acc[j], a[i + j]);
+            }
+        }
+        for (size_t j = 0; i + j < n; ++j) {
+            acc[j] = op(acc[j], a[i + j]);
+        }
+        return Tree(acc, ReduceLanes, op);
+    }
+
+    // Result of VARGMAX and VARGMIN: the extreme value and the index of its first occurrence.
+    template <typename T>
+    struct Arg {
+        T value;
+        uint32_t index;
+    };
+
+    // Combine of two Args under Max or Min, the lower index winning ties, so any grouping
+    // gives the same result.
+    template <typename Op>
+    struct ArgOp {
+        template <typename T>
+        Arg<T> operator()(Arg<T> a, Arg<T> b) const {
+            return Op::Prefer(b.value, a.value) || (b.value == a.value && b.index < a.index) ? b : a;
+        }
+    };
+
+    // Arg of a[0, n), indices counted from first. init seeds every lane like Fold's.
+    template <typename T, typename Op>
+    Arg<T> ArgFold(const T* a, size_t n, uint32_t first, Arg<T> init, Op) {
+        T val[ReduceLanes];
+        uint32_t idx[ReduceLanes];
+        std::fill(val, val + ReduceLanes, init.value);
+        std::fill(idx, idx + ReduceLanes, init.index);
+        size_t i = 0;
+        for (; i + ReduceLanes <= n; i += ReduceLanes) {
+            for (size_t j = 0; j < ReduceLanes; ++j) {
+                bool take = Op::Prefer(a[i + j], val[j]);
+                val[j] = take ? a[i + j] : val[j];
+                idx[j] = take ? uint32_t(first + i + j) : idx[j];
+            }
+        }
+        for (size_t j = 0; i + j < n; ++j) {
+            if (Op::Prefer(a[i + j], val[j])) {
+                val[j] = a[i + j];
+                idx[j] = uint32_t(first + i + j);
+            }
+        }
+        Arg<T> lanes[ReduceLanes];
+        for (size_t j = 0; j < ReduceLanes; ++j) {
+            lanes[j] = {val[j], idx[j]};
+        }
+        return Tree(lanes, ReduceLanes, ArgOp<Op>());
+    }
+
+}  // namespace vec
+}  // namespace tai
+
+#endif //TAI_SIM_TAI_VEC_H
@@ -220,6 +220,18 @@ namespace tai {
             acc->dram_.Free(buffer);
         }
 
+        void PrewarmFft(uint32_t len) {
+            acc->fft_plans_.Prewarm(len);
+        }
+
+        tai::FftProfile GetFftProfile() {
+            return acc->fft_profile_;
+        }
+
+        size_t FftPlanCount() {
+            return acc->fft_plans_.Size();
+        }
+
         void MemCopyFromHost(void* dst, const void* src, size_t size) {
             memcpy(dst, src, size);
         }
@@ -299,6 +311,21 @@ void fpga_free_dma(HANDLE dma) {
     tai::CommandQueue::ThreadLocal()->FreeBuffer(dma);
 }
 
+void fpga_fft_prewarm(unsigned long long len) {
+    tai::CommandQueue::ThreadLocal()->PrewarmFft(len);
+}
+
+double fpga_fft_profile(unsigned long long* len, unsigned long long* nsec) {
+    auto prof = tai::CommandQueue::ThreadLocal()->GetFftProfile();
+    if (len) *len = prof.len;
+    if (nsec) *nsec = prof.nsec;
+    return prof.gflops;
+}
+
+unsigned long long fpga_fft_plan_count() {
+    return tai::CommandQueue::ThreadLocal()->FftPlanCount();
+}
+
 
 
 
@@ -332,7 +359,7 @@ T print(T arg)
 //template <class ...Args>
 //unsigned int _API_CALL fpga_set_irq_callback(unsigned int user_irq_num,char* func, Args...args) {
 //unsigned int _API_CALL fpga_set_irq_callback(unsigned int user_irq_num,char* func, size_t argsize, unsigned int* a = 0) {
-unsigned int _API_CALL fpga_set_irq_callback(unsigned int user_irq_num,char* func) {
+unsigned int _API_CALL fpga_set_irq_callback(unsigned int user_irq_num,const char* func) {
 
     while (user_irq_num&&func) {
         //std::vector<int> a = { (print(args))... };
@@ -372,6 +399,37 @@ void fpga_open() {
     fpga_set_irq_callback(4, "VmulC32");
     fpga_set_irq_callback(5, "Fir");
     fpga_set_irq_callback(6, "Ddc");
+    fpga_set_irq_callback(7, "FftBatch");
+    fpga_set_irq_callback(8, "IfftBatch");
+    fpga_set_irq_callback(9, "Rfft");
+    fpga_set_irq_callback(10, "Irfft");
+    fpga_set_irq_callback(11, "FirInit");
+    fpga_set_irq_callback(12, "FirStream");
+    fpga_set_irq_callback(13, "FirDecim");
+    fpga_set_irq_callback(14, "DdcStream");
+    fpga_set_irq_callback(15, "Fft2d");
+    fpga_set_irq_callback(16, "Ifft2d");
+    fpga_set_irq_callback(17, "FftI16");
+    fpga_set_irq_callback(18, "IfftI16");
+    fpga_set_irq_callback(19, "FftWin");
+    fpga_set_irq_callback(20, "MfPrep");
+    fpga_set_irq_callback(21, "MfBank");
+    fpga_set_irq_callback(22, "FftPrune");
+    fpga_set_irq_callback(23, "Czt");
+    fpga_set_irq_callback(24, "ChanInit");
+    fpga_set_irq_callback(25, "Chan");
+    fpga_set_irq_callback(26, "VmulAbsLog10");
+    fpga_set_irq_callback(27, "Vexp");
+    fpga_set_irq_callback(28, "Vlog10");
+    fpga_set_irq_callback(29, "Vsum");
+    fpga_set_irq_callback(30, "Vargmax");
+    fpga_set_irq_callback(31, "Vargmin");
+    fpga_set_irq_callback(32, "VsumAxis");
+    fpga_set_irq_callback(33, "VmaxSeg");
+    fpga_set_irq_callback(34, "VaddStrided");
+    fpga_set_irq_callback(35, "GemmF32");
+    fpga_set_irq_callback(36, "Vop");
+    fpga_set_irq_callback(37, "ConvFft");
 }
 
 
@@ -390,7 +448,7 @@ unsigned int _API_CALL fpga_wait_irq(unsigned int user_irq_num, unsigned int tim
         auto iter = irqSet.find(user_irq_num);
 
         std::string s1 = iter->second->func_name;
-        char inst1[50] = { 0 };
+        char inst1[96] = { 0 };
         
 
         //if (strcmp(s1, "Fft") == 0) {
@@ -564,9 +622,765 @@ unsigned int _API_CALL fpga_wait_irq(unsigned int user_irq_num, unsigned int tim
             snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "X_SIZE", (int64_t)argsSize);
             TAIPushInst(inst1);
 
+            // Each Ddc launch is independent, DdcStream keeps the oscillator running.
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "NCO_STEP", (int64_t)0);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "NCO_PHASE", (int64_t)0);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "DDC #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FftBatch" || s1 == "IfftBatch") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto batch = reinterpret_cast<size_t*>(args[3]);
+            auto stride = reinterpret_cast<size_t*>(args[4]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "BATCH", (int64_t)batch);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "ROW_STRIDE", (int64_t)stride);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x",
+                     s1 == "FftBatch" ? "FFT.BATCH" : "IFFT.BATCH", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Rfft" || s1 == "Irfft") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x",
+                     s1 == "Rfft" ? "RFFT" : "IRFFT", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FirInit") {
+            void* state_addr = args[0];
+            void* c_addr = args[1];
+            auto taps = reinterpret_cast<size_t*>(args[2]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)state_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)taps);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "FIR.INIT #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FirStream") {
+            void* a_addr = args[0];
+            void* state_addr = args[1];
+            void* res_addr = args[2];
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)state_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "FIR.STREAM #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FirDecim") {
+            void* a_addr = args[0];
+            void* c_addr = args[1];
+            void* res_addr = args[2];
+            auto s2 = reinterpret_cast<size_t*>(args[3]);
+            auto s3 = reinterpret_cast<size_t*>(args[4]);
+            auto s4 = reinterpret_cast<size_t*>(args[5]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "ULEN", (int64_t)s2);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)s3);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "X_SIZE", (int64_t)s4);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "FIR.DECIM #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "DdcStream") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto step = reinterpret_cast<size_t*>(args[3]);
+            auto reset = reinterpret_cast<size_t*>(args[4]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "X_SIZE", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "NCO_STEP", (int64_t)step);
+            TAIPushInst(inst1);
+
+            if (reset) {
+                snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "NCO_PHASE", (int64_t)0);
+                TAIPushInst(inst1);
+            }
+
             snprintf(inst1, sizeof(inst1), "DDC #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
             TAIPushInst(inst1);
 
+            TAISynchronize();
+        }
+
+        if (s1 == "Fft2d" || s1 == "Ifft2d") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto s2 = reinterpret_cast<size_t*>(args[2]);
+            auto s3 = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "X_SIZE", (int64_t)s2);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "Y_SIZE", (int64_t)s3);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x",
+                     s1 == "Fft2d" ? "FFT2D" : "IFFT2D", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FftI16" || s1 == "IfftI16") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            void* exp_addr = args[2];
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)exp_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x",
+                     s1 == "FftI16" ? "FFT.I16" : "IFFT.I16", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FftWin") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto window = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "WINDOW", (int64_t)window);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "FFT.WIN #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "MfPrep") {
+            void* tmpl_addr = args[0];
+            void* res_addr = args[1];
+            auto tlen = reinterpret_cast<size_t*>(args[2]);
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+            auto batch = reinterpret_cast<size_t*>(args[4]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)tmpl_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "ULEN", (int64_t)tlen);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "BATCH", (int64_t)batch);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "ROW_STRIDE", (int64_t)0);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MF.PREP #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "MfBank") {
+            void* a_addr = args[0];
+            void* spectra_addr = args[1];
+            void* res_addr = args[2];
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+            auto batch = reinterpret_cast<size_t*>(args[4]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)spectra_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "BATCH", (int64_t)batch);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MF.BANK #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x",
+                     (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "FftPrune") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto first = reinterpret_cast<size_t*>(args[3]);
+            auto stride = reinterpret_cast<size_t*>(args[4]);
+            auto count = reinterpret_cast<size_t*>(args[5]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "BIN_FIRST", (int64_t)first);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "BIN_STRIDE", (int64_t)stride);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "BIN_COUNT", (int64_t)count);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "FFT.PRUNE #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Czt") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto start = reinterpret_cast<size_t*>(args[3]);
+            auto step = reinterpret_cast<size_t*>(args[4]);
+            auto points = reinterpret_cast<size_t*>(args[5]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "CZT_START", (int64_t)start);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "CZT_STEP", (int64_t)step);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "CZT_POINTS", (int64_t)points);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "CZT #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "ChanInit") {
+            void* state_addr = args[0];
+            void* c_addr = args[1];
+            auto taps = reinterpret_cast<size_t*>(args[2]);
+            auto channels = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)state_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)taps);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "CHANNELS", (int64_t)channels);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "CHAN.INIT #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Chan") {
+            void* a_addr = args[0];
+            void* state_addr = args[1];
+            void* res_addr = args[2];
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)state_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "CHAN #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x",
+                     (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "VmulAbsLog10") {
+            void* a_addr = args[0];
+            void* c_addr = args[1];
+            void* res_addr = args[2];
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            // driven by the VMUL.C32 below, fused with it into one tiled pass
+            snprintf(inst1, sizeof(inst1), "VABS.C32 #0x0, #DATA, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)160);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VLOG10.F32 #0x0, #DATA, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)160);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VMUL.C32 #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Vexp") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto mode = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "MATH_MODE", (int64_t)mode);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VEXP.F32 #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Vlog10") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+            auto mode = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "MATH_MODE", (int64_t)mode);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VLOG10.F32 #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Vsum") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VSUM.F32 #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Vargmax") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VARGMAX.F32 #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Vargmin") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto argsSize = reinterpret_cast<size_t*>(args[2]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VARGMIN.F32 #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "VsumAxis") {
+            void* a_addr = args[0];
+            void* res_addr = args[1];
+            auto ndim = reinterpret_cast<size_t*>(args[2]);
+            auto x_size = reinterpret_cast<size_t*>(args[3]);
+            auto y_size = reinterpret_cast<size_t*>(args[4]);
+            auto z_size = reinterpret_cast<size_t*>(args[5]);
+            auto axis = reinterpret_cast<size_t*>(args[6]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "NDIM", (int64_t)ndim);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "X_SIZE", (int64_t)x_size);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "Y_SIZE", (int64_t)y_size);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "Z_SIZE", (int64_t)z_size);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "REDUCE_AXIS", (int64_t)axis);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VSUM.AXIS.F32 #0x0, #INST, #MEM, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "VmaxSeg") {
+            void* a_addr = args[0];
+            void* off_addr = args[1];
+            void* res_addr = args[2];
+            auto count = reinterpret_cast<size_t*>(args[3]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)off_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "SEGMENTS", (int64_t)count);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "VMAX.SEG.F32 #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "VaddStrided") {
+            void* a_addr = args[0];
+            void* c_addr = args[1];
+            void* res_addr = args[2];
+            auto argsSize = reinterpret_cast<size_t*>(args[3]);
+            // strides of a, c and res, then their index arrays, 0 for none
+            const char* layout[] = {"VS0_STRIDE", "VS1_STRIDE", "VD_STRIDE", "VS0_INDEX", "VS1_INDEX", "VD_INDEX"};
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            for (int i = 0; i < 6; ++i) {
+                snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", layout[i], (int64_t)args[4 + i]);
+                TAIPushInst(inst1);
+            }
+
+            snprintf(inst1, sizeof(inst1), "VADD.F32 #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            // later launches expect packed operands
+            for (int i = 0; i < 6; ++i) {
+                snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", layout[i], (int64_t)0);
+                TAIPushInst(inst1);
+            }
+
+            TAISynchronize();
+        }
+
+        if (s1 == "GemmF32") {
+            void* a_addr = args[0];
+            void* b_addr = args[1];
+            void* res_addr = args[2];
+            auto m = reinterpret_cast<size_t*>(args[3]);
+            auto k = reinterpret_cast<size_t*>(args[4]);
+            auto n = reinterpret_cast<size_t*>(args[5]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)b_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "X_SIZE", (int64_t)m);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "Y_SIZE", (int64_t)k);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "Z_SIZE", (int64_t)n);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "GEMM.F32 #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "ConvFft") {
+            void* a_addr = args[0];
+            void* c_addr = args[1];
+            void* res_addr = args[2];
+            auto s2 = reinterpret_cast<size_t*>(args[3]);
+            auto s3 = reinterpret_cast<size_t*>(args[4]);
+            auto taps = reinterpret_cast<size_t*>(args[5]);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "ULEN", (int64_t)s2);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)s3);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "CONV_FFT_TAPS", (int64_t)taps);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "CONV #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            TAIPushInst(inst1);
+
+            // later launches go back to the cost model
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "CONV_FFT_TAPS", (int64_t)0);
+            TAIPushInst(inst1);
+
+            TAISynchronize();
+        }
+
+        if (s1 == "Vop") {
+            // one vector instruction by mnemonic: res = op(a, c), op(a) when c is null, or
+            // op(a, imm) with imm pointing to the host immediate
+            auto op = reinterpret_cast<const char*>(args[0]);
+            void* res_addr = args[1];
+            void* a_addr = args[2];
+            void* c_addr = args[3];
+            auto argsSize = reinterpret_cast<size_t*>(args[4]);
+            void* imm = args[5];
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)160, (int64_t)res_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)161, (int64_t)a_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVI $0x%x, #0x%lx", (uint32_t)162, (int64_t)c_addr);
+            TAIPushInst(inst1);
+
+            snprintf(inst1, sizeof(inst1), "MOVID $%s, #0x%lx", "VLEN", (int64_t)argsSize);
+            TAIPushInst(inst1);
+
+            if (imm) {
+                // complex double immediates take two words, the rest one word of their size
+                uint64_t word[2] = {0, 0};
+                size_t bytes = strstr(op, ".C64") ? 16 : (strstr(op, ".C32") || strstr(op, ".F64")) ? 8 : 4;
+                memcpy(word, imm, bytes);
+                if (bytes == 16) {
+                    snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x, #0x%lx, #0x%lx", op, (uint32_t)160, (uint32_t)161, word[0], word[1]);
+                } else {
+                    snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x, #0x%lx", op, (uint32_t)160, (uint32_t)161, word[0]);
+                }
+            } else if (c_addr) {
+                snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x, $0x%x", op, (uint32_t)160, (uint32_t)161, (uint32_t)162);
+            } else {
+                snprintf(inst1, sizeof(inst1), "%s #0x0, #INST, #MEM, $0x%x, $0x%x", op, (uint32_t)160, (uint32_t)161);
+            }
+            TAIPushInst(inst1);
+
             TAISynchronize();
         }/**/
 
@@ -756,6 +1570,33 @@ static uint32_t parseSpecName(const char **str) {
     if (strcmp(name, "ACCUM_OFFSET") == 0) return tai::SpecRegNames::ACCUM_OFFSET;
     if (strcmp(name, "CONST_OFFSET") == 0) return tai::SpecRegNames::CONST_OFFSET;
     if (strcmp(name, "INPUT_OFFSET") == 0) return tai::SpecRegNames::INPUT_OFFSET;
+    if (strcmp(name, "BATCH") == 0) return tai::SpecRegNames::BATCH;
+    if (strcmp(name, "ROW_STRIDE") == 0) return tai::SpecRegNames::ROW_STRIDE;
+    if (strcmp(name, "CONV_FFT_TAPS") == 0) return tai::SpecRegNames::CONV_FFT_TAPS;
+    if (strcmp(name, "NCO_STEP") == 0) return tai::SpecRegNames::NCO_STEP;
+    if (strcmp(name, "NCO_PHASE") == 0) return tai::SpecRegNames::NCO_PHASE;
+    if (strcmp(name, "BFP_EXP") == 0) return tai::SpecRegNames::BFP_EXP;
+    if (strcmp(name, "FFT_LARGE") == 0) return tai::SpecRegNames::FFT_LARGE;
+    if (strcmp(name, "WINDOW") == 0) return tai::SpecRegNames::WINDOW;
+    if (strcmp(name, "BIN_FIRST") == 0) return tai::SpecRegNames::BIN_FIRST;
+    if (strcmp(name, "BIN_STRIDE") == 0) return tai::SpecRegNames::BIN_STRIDE;
+    if (strcmp(name, "BIN_COUNT") == 0) return tai::SpecRegNames::BIN_COUNT;
+    if (strcmp(name, "CZT_START") == 0) return tai::SpecRegNames::CZT_START;
+    if (strcmp(name, "CZT_STEP") == 0) return tai::SpecRegNames::CZT_STEP;
+    if (strcmp(name, "CZT_POINTS") == 0) return tai::SpecRegNames::CZT_POINTS;
+    if (strcmp(name, "CHANNELS") == 0) return tai::SpecRegNames::CHANNELS;
+    if (strcmp(name, "CHAN_FRAMES") == 0) return tai::SpecRegNames::CHAN_FRAMES;
+    if (strcmp(name, "VEC_THREADS") == 0) return tai::SpecRegNames::VEC_THREADS;
+    if (strcmp(name, "VEC_PAR_MIN") == 0) return tai::SpecRegNames::VEC_PAR_MIN;
+    if (strcmp(name, "MATH_MODE") == 0) return tai::SpecRegNames::MATH_MODE;
+    if (strcmp(name, "REDUCE_AXIS") == 0) return tai::SpecRegNames::REDUCE_AXIS;
+    if (strcmp(name, "SEGMENTS") == 0) return tai::SpecRegNames::SEGMENTS;
+    if (strcmp(name, "VD_STRIDE") == 0) return tai::SpecRegNames::VD_STRIDE;
+    if (strcmp(name, "VS0_STRIDE") == 0) return tai::SpecRegNames::VS0_STRIDE;
+    if (strcmp(name, "VS1_STRIDE") == 0) return tai::SpecRegNames::VS1_STRIDE;
+    if (strcmp(name, "VD_INDEX") == 0) return tai::SpecRegNames::VD_INDEX;
+    if (strcmp(name, "VS0_INDEX") == 0) return tai::SpecRegNames::VS0_INDEX;
+    if (strcmp(name, "VS1_INDEX") == 0) return tai::SpecRegNames::VS1_INDEX;
     return -1;
 }
 static bool isAIInst(const char *op) {
@@ -770,9 +1611,12 @@ static bool isAIInst(const char *op) {
 		strcmp(op4, "MSTO") == 0 || strcmp(op4, "TSTO") == 0 || strcmp(op4, "MCLI") == 0 ||
 		strcmp(op4, "GEMM") == 0 || strcmp(op4, "CONV") == 0 || strcmp(op4, "VSUM") == 0 ||
         strcmp(op4, "VMAX") == 0 || strcmp(op4, "VMIN") == 0 || strcmp(op4, "VREC") == 0 ||
+        strcmp(op4, "VARG") == 0 ||
         strcmp(op3, "MMP") == 0 || strcmp(op3, "MMA") == 0 || strcmp(op3, "SMM") == 0 || 
         strcmp(op3, "MVP") == 0 || strcmp(op3, "FFT") == 0 || strcmp(op4, "IFFT") == 0 || 
-        strcmp(op3, "FIR") == 0 || strcmp(op3, "DDC") == 0 || strcmp(op4, "EXTR") == 0) {
+        strcmp(op3, "FIR") == 0 || strcmp(op3, "DDC") == 0 || strcmp(op4, "EXTR") == 0 ||
+        strcmp(op4, "RFFT") == 0 || strcmp(op4, "IRFF") == 0 || strcmp(op3, "MF.") == 0 ||
+        strcmp(op, "CZT") == 0 || strcmp(op4, "CHAN") == 0) {
 		return true;
 	}
 	return false;
@@ -823,7 +1667,9 @@ static bool is3Addr(const char *op) {
         strcmp(op4, "VSTO") == 0 || strcmp(op4, "MSTO") == 0 || strcmp(op4, "TSTO") == 0 || 
         strcmp(op4, "MCLI") == 0 || strcmp(op4, "GEMM") == 0 || strcmp(op4, "CONV") == 0 ||
         strcmp(op3, "MMP") == 0 || strcmp(op3, "MMA") == 0 || strcmp(op3, "SMM") == 0 ||
-        strcmp(op3, "MVP") == 0) {
+        strcmp(op3, "MVP") == 0 || strcmp(op, "FIR.STREAM") == 0 ||
+        strcmp(op, "FIR.DECIM") == 0 || strcmp(op, "FFT.I16") == 0 || strcmp(op, "IFFT.I16") == 0 ||
+        strcmp(op, "MF.BANK") == 0 || strcmp(op, "CHAN") == 0 || strstr(op, ".SEG.") != NULL) {
 		return true;
     }
     return false;
@@ -865,6 +1711,10 @@ void TAIPushInst(const char* inst) {
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VaddF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
         else if (strcmp(op, "VADD.F64") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VaddF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VADD.C32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VaddC32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VADD.C64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VaddC64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
         else if (strcmp(op, "VADDI.I32") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VaddiI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, *((int32_t *)(&rs1)));
         else if (strcmp(op, "VADDI.F32") == 0)
@@ -895,6 +1745,8 @@ void TAIPushInst(const char* inst) {
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmulF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
         else if (strcmp(op, "VMUL.C32") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmulC32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMUL.C64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmulC64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
         else if (strcmp(op, "VMULI.I32") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmuliI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, *((int32_t *)(&rs1)));
         else if (strcmp(op, "VMULI.F32") == 0)
@@ -970,6 +1822,54 @@ void TAIPushInst(const char* inst) {
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
         else if (strcmp(op, "VMIN.F64") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);  
+        else if (strcmp(op, "VSUM.AXIS.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VsumAxisI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VSUM.AXIS.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VsumAxisF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VSUM.AXIS.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VsumAxisF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VMAX.AXIS.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmaxAxisI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VMAX.AXIS.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmaxAxisF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VMAX.AXIS.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmaxAxisF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VMIN.AXIS.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminAxisI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VMIN.AXIS.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminAxisF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VMIN.AXIS.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminAxisF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VSUM.SEG.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VsumSegI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VSUM.SEG.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VsumSegF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VSUM.SEG.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VsumSegF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMAX.SEG.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmaxSegI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMAX.SEG.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmaxSegF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMAX.SEG.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VmaxSegF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMIN.SEG.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminSegI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMIN.SEG.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminSegF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VMIN.SEG.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VminSegF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "VARGMAX.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VargmaxI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VARGMAX.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VargmaxF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VARGMAX.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VargmaxF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VARGMIN.I32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VargminI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VARGMIN.F32") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VargminF32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "VARGMIN.F64") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->VargminF64(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
         else if (strcmp(op, "TRANSPOSE.I32") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->TransposeI32(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
         else if (strcmp(op, "TRANSPOSE.F32") == 0)
@@ -1020,6 +1920,42 @@ void TAIPushInst(const char* inst) {
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Fft(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
         else if (strcmp(op, "IFFT") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Ifft(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "FFT.PRUNE") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FftPrune(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "CZT") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Czt(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "FFT.WIN") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FftWin(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "FIR.INIT") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FirInit(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "FIR.STREAM") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FirStream(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "CHAN.INIT") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->ChanInit(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "CHAN") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Chan(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "FIR.DECIM") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FirDecim(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "FFT.I16") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FftI16(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "IFFT.I16") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->IfftI16(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "MF.PREP") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->MfPrep(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "MF.BANK") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->MfBank(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
+        else if (strcmp(op, "FFT2D") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Fft2d(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "IFFT2D") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Ifft2d(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "RFFT") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Rfft(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "IRFFT") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Irfft(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "FFT.BATCH") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->FftBatch(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
+        else if (strcmp(op, "IFFT.BATCH") == 0)
+            ret = tai::CommandQueue::ThreadLocal()->GetProgram()->IfftBatch(path, dri, dro, (uint32_t)rd, (uint32_t)rs0);
         else if (strcmp(op, "FIR") == 0)
             ret = tai::CommandQueue::ThreadLocal()->GetProgram()->Fir(path, dri, dro, (uint32_t)rd, (uint32_t)rs0, (uint32_t)rs1);
         else if (strcmp(op, "EXTR") == 0)
@@ -0,0 +1,655 @@
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "../include/tai_dsp.h"
+#include "../include/tai_sim.h"
+#include "../include/tai_simd.h"
+
+using namespace tai;
+
+namespace {
+
+    // Relative cost of one real FFT butterfly against one multiply-add of the direct loop.
+    constexpr double FftCostFactor = 1.5;
+
+    // Block length for overlap-save with k taps over len outputs: the power of two with the
+    // lowest estimated total cost, never shorter than twice the taps.
+    uint32_t ConvBlock(uint32_t k, uint64_t len, double* cost) {
+        uint32_t best = 0;
+        double best_cost = 0;
+        uint32_t m = 2;
+        while (m < 2 * k) m <<= 1;
+        for (;; m <<= 1) {
+            const uint64_t step = m - k + 1;
+            const uint64_t blocks = (len + step - 1) / step;
+            const double c = FftCostFactor * blocks * m * (std::log2(m) + 1.0);
+            if (best == 0 || c < best_cost) {
+                best = m;
+                best_cost = c;
+            }
+            if (step >= len || m >= (1u << 30)) break;
+        }
+        if (cost) *cost = best_cost;
+        return best;
+    }
+
+    template <typename Real>
+    inline void Store(Real v, float* out) {
+        *out = static_cast<float>(v);
+    }
+
+    template <typename Real>
+    inline void Store(Real v, int32_t* out) {
+        *out = static_cast<int32_t>(static_cast<uint32_t>(std::llround(v)));
+    }
+
+    // Transform every column of a rows x cols row-major matrix in place. Columns are gathered
+    // ColumnTile at a time into a contiguous per-thread buffer, about one cache line per row,
+    // and transformed out of place into a second one before being scattered back.
+    void ColumnPass(Pool& pool, const FftPlan<float>& plan, std::complex<float>* data,
+                    uint32_t rows, uint32_t cols) {
+        pool.ParallelFor((cols + ColumnTile - 1) / ColumnTile, [&](uint32_t t) {
+            static thread_local std::vector<std::complex<float>> buf, res;
+            const uint32_t c0 = t * ColumnTile;
+            const uint32_t w = std::min(ColumnTile, cols - c0);
+            buf.resize(static_cast<size_t>(w) * rows);
+            res.resize(static_cast<size_t>(w) * rows);
+
+            for (uint32_t r = 0; r < rows; ++r) {
+                const std::complex<float>* src = data + static_cast<size_t>(r) * cols + c0;
+                for (uint32_t b = 0; b < w; ++b) buf[static_cast<size_t>(b) * rows + r] = src[b];
+            }
+            for (uint32_t b = 0; b < w; ++b) {
+                plan.Execute(buf.data() + static_cast<size_t>(b) * rows, res.data() + static_cast<size_t>(b) * rows);
+            }
+            for (uint32_t r = 0; r < rows; ++r) {
+                std::complex<float>* dst = data + static_cast<size_t>(r) * cols + c0;
+                for (uint32_t b = 0; b < w; ++b) dst[b] = res[static_cast<size_t>(b) * rows + r];
+            }
+        });
+    }
+
+    // Largest divisor of n not above sqrt(n), 0 if there is none.
+    uint32_t SmallFactor(uint32_t n) {
+        uint32_t f = static_cast<uint32_t>(std::sqrt(static_cast<double>(n)));
+        while (f > 1 && n % f != 0) --f;
+        return f > 1 ? f : 0;
+    }
+
+    inline std::complex<float> Mul(std::complex<float> a, std::complex<float> b) {
+        return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+    }
+
+    // Relative cost per sample of one Goertzel bin against one FFT butterfly.
+    constexpr double GoertzelCostFactor = 2.0;
+    // Fixed cost of one short plan execution, in butterflies.
+    constexpr double PlanCallCost = 32.0;
+
+    // Sub-transform length l for a run of count bins of an m-point transform: the divisor of m,
+    // at least count, with the lowest cost for m / l l-point transforms plus the per-bin combine.
+    uint32_t RangeFactor(uint32_t m, uint32_t count, double* cost) {
+        uint32_t best = m;
+        double best_cost = m * std::log2(std::max(m, 2u)) + PlanCallCost;
+        for (uint32_t f = 1; static_cast<uint64_t>(f) * f <= m; ++f) {
+            if (m % f != 0) continue;
+            for (uint32_t l : {f, m / f}) {
+                if (l < count || l < 2 || l == m) continue;
+                const double r = m / l;
+                const double c = m * std::log2(l) + r * PlanCallCost + static_cast<double>(count) * r;
+                if (c < best_cost) {
+                    best = l;
+                    best_cost = c;
+                }
+            }
+        }
+        if (cost) *cost = best_cost;
+        return best;
+    }
+
+    // Bin k of the n-point forward transform. The recurrence runs one step past the input,
+    // where s[n] - exp(-i w) s[n - 1] is the bin.
+    std::complex<float> Goertzel(const std::complex<float>* x, uint32_t n, uint32_t k) {
+        const double w = 2.0 * M_PI * k / n;
+        const double coef = 2.0 * std::cos(w);
+        double r1 = 0, r2 = 0, i1 = 0, i2 = 0;
+        for (uint32_t m = 0; m < n; ++m) {
+            const double r0 = x[m].real() + coef * r1 - r2;
+            const double i0 = x[m].imag() + coef * i1 - i2;
+            r2 = r1;
+            r1 = r0;
+            i2 = i1;
+            i1 = i0;
+        }
+        const double r0 = coef * r1 - r2, i0 = coef * i1 - i2;
+        const double c = std::cos(w), s = std::sin(w);
+        return {static_cast<float>(r0 - (c * r1 + s * i1)), static_cast<float>(i0 - (c * i1 - s * r1))};
+    }
+
+    // exp(-2 pi i p / 2^65). The phase is kept as an exact integer so chirps stay accurate
+    // for indices whose square no longer fits a double.
+    std::complex<float> Cycle65(unsigned __int128 p) {
+        const unsigned __int128 mask = (static_cast<unsigned __int128>(1) << 65) - 1;
+        const double a = -2.0 * M_PI * std::ldexp(static_cast<double>(p & mask), -65);
+        return {static_cast<float>(std::cos(a)), static_cast<float>(std::sin(a))};
+    }
+
+    // Bins (first + j) % m, j < count <= l, of the m-point forward transform of y. With
+    // m = l * r and y viewed as l rows of r, column c transforms to Z_c and bin k is
+    // sum_c exp(-2 pi i c k / m) Z_c[k % l]. y is overwritten.
+    void FftRange(FftPlanCache& plans, Pool& pool, std::complex<float>* y, uint32_t m, uint32_t l,
+                  uint32_t first, uint32_t count, std::complex<float>* out) {
+        const uint32_t r = m / l;
+        if (r == 1) {
+            static thread_local std::vector<std::complex<float>> full;
+            full.resize(m);
+            plans.Get<float>(m, FftDir::Forward)->Execute(y, full.data());
+            for (uint32_t j = 0; j < count; ++j) out[j] = full[(first + j) % m];
+            return;
+        }
+
+        ColumnPass(pool, *plans.Get<float>(l, FftDir::Forward), y, l, r);
+
+        const uint32_t per_task = 16;
+        pool.ParallelFor((count + per_task - 1) / per_task, [&](uint32_t t) {
+            const uint32_t end = std::min(count, (t + 1) * per_task);
+            for (uint32_t j = t * per_task; j < end; ++j) {
+                const uint32_t k = static_cast<uint32_t>((static_cast<uint64_t>(first) + j) % m);
+                const std::complex<float>* z = y + static_cast<size_t>(k % l) * r;
+                const double a = -2.0 * M_PI * k / m;
+                const double c = std::cos(a), s = std::sin(a);
+                double wr = 1, wi = 0, accr = 0, acci = 0;
+                for (uint32_t col = 0; col < r; ++col) {
+                    accr += wr * z[col].real() - wi * z[col].imag();
+                    acci += wr * z[col].imag() + wi * z[col].real();
+                    const double t0 = wr * c - wi * s;
+                    wi = wr * s + wi * c;
+                    wr = t0;
+                }
+                out[j] = {static_cast<float>(accr), static_cast<float>(acci)};
+            }
+        });
+    }
+
+}  // namespace
+
+bool tai::UseFastConv(uint32_t ulen, uint32_t vlen, uint32_t taps) {
+    const uint32_t k = std::min(ulen, vlen);
+    if (k < 2) return false;
+    if (taps != 0) return k >= taps;
+    double cost;
+    ConvBlock(k, static_cast<uint64_t>(ulen) + vlen - 1, &cost);
+    return cost < static_cast<double>(ulen) * vlen;
+}
+
+template <typename In, typename Real>
+void tai::FastConv(FftPlanCache& plans, Pool& pool, const In* u, uint32_t ulen,
+                   const In* v, uint32_t vlen, In* out) {
+    // Convolution commutes, slide the longer operand past the shorter one.
+    if (ulen < vlen) {
+        std::swap(u, v);
+        std::swap(ulen, vlen);
+    }
+    const uint32_t n = ulen, k = vlen;
+    const uint64_t len = static_cast<uint64_t>(n) + k - 1;
+    const uint32_t m = ConvBlock(k, len, nullptr);
+    const uint32_t step = m - k + 1;
+    const uint32_t blocks = static_cast<uint32_t>((len + step - 1) / step);
+    auto plan = plans.GetReal<Real>(m);
+
+    std::vector<std::complex<Real>> kernel(m / 2 + 1);
+    auto taps = reinterpret_cast<Real*>(kernel.data());
+    std::fill(taps, taps + m, Real(0));
+    for (uint32_t j = 0; j != k; ++j) taps[j] = static_cast<Real>(v[j]);
+    plan->Forward(taps, kernel.data());
+
+    // Block b produces out[b * step, (b + 1) * step) from the m inputs ending at the last of them.
+    pool.ParallelFor(blocks, [&](uint32_t b) {
+        static thread_local std::vector<std::complex<Real>> buf;
+        buf.resize(m / 2 + 1);
+        auto seg = reinterpret_cast<Real*>(buf.data());
+
+        const int64_t start = static_cast<int64_t>(b) * step - (k - 1);
+        const int64_t lo = std::max<int64_t>(0, -start);
+        const int64_t hi = std::min<int64_t>(m, static_cast<int64_t>(n) - start);
+        std::fill(seg, seg + m, Real(0));
+        for (int64_t j = lo; j < hi; ++j) seg[j] = static_cast<Real>(u[start + j]);
+
+        plan->Forward(seg, buf.data());
+        for (uint32_t j = 0; j != m / 2 + 1; ++j) buf[j] *= kernel[j];
+        plan->Inverse(buf.data(), seg);
+
+        const uint64_t first = static_cast<uint64_t>(b) * step;
+        const uint32_t cnt = static_cast<uint32_t>(std::min<uint64_t>(step, len - first));
+        for (uint32_t j = 0; j != cnt; ++j) Store(seg[k - 1 + j], out + first + j);
+    });
+}
+
+void tai::FirStateInit(FirState* st, const float* taps, uint32_t n) {
+    st->taps = n;
+    st->reserved = 0;
+    std::copy(taps, taps + n, st->Coef());
+    if (n > 0) std::fill(st->History(), st->History() + n - 1, 0.0f);
+}
+
+void tai::FirStream(FftPlanCache& plans, Pool& pool, FirState* st, const float* in, uint32_t len,
+                    float* out, uint32_t fft_taps) {
+    const uint32_t k = st->taps;
+    if (k == 0) {
+        std::fill(out, out + len, 0.0f);
+        return;
+    }
+    const uint32_t hist = k - 1;
+    const float* h = st->Coef();
+
+    // History followed by the new block, so every output sees a full window.
+    static thread_local std::vector<float> ext;
+    ext.resize(hist + len);
+    std::copy(st->History(), st->History() + hist, ext.begin());
+    std::copy(in, in + len, ext.begin() + hist);
+
+    if (UseFastConv(hist + len, k, fft_taps)) {
+        static thread_local std::vector<float> full;
+        full.resize(hist + len + hist);
+        FastConv<float, float>(plans, pool, ext.data(), hist + len, h, k, full.data());
+        std::copy(full.begin() + hist, full.begin() + hist + len, out);
+    } else {
+        for (uint32_t i = 0; i < len; ++i) {
+            const float* x = ext.data() + hist + i;
+            float acc = 0;
+            for (uint32_t j = 0; j < k; ++j) acc += h[j] * x[-int64_t(j)];
+            out[i] = acc;
+        }
+    }
+    std::copy(ext.end() - hist, ext.end(), st->History());
+}
+
+void tai::FirDecimate(Pool& pool, const float* u, uint32_t ulen, const float* v, uint32_t vlen,
+                      uint32_t d, float* out) {
+    if (ulen == 0 || vlen == 0 || d == 0) return;
+    const uint64_t len = static_cast<uint64_t>(ulen) + vlen - 1;
+    const uint32_t outs = static_cast<uint32_t>((len - 1) / d + 1);
+
+    // y[j] = sum_s r[s] * u[j * d - (vlen - 1) + s] with r the reversed taps.
+    std::vector<float> r(v, v + vlen);
+    std::reverse(r.begin(), r.end());
+
+    const uint32_t chunk = 1024;
+    pool.ParallelFor((outs + chunk - 1) / chunk, [&](uint32_t t) {
+        const uint32_t end = std::min<uint32_t>(outs, (t + 1) * chunk);
+        for (uint32_t j = t * chunk; j < end; ++j) {
+            const int64_t base = static_cast<int64_t>(j) * d - (vlen - 1);
+            const int64_t lo = std::max<int64_t>(0, -base);
+            const int64_t hi = std::min<int64_t>(vlen, static_cast<int64_t>(ulen) - base);
+            float acc = 0;
+            for (int64_t s = lo; s < hi; ++s) acc += r[s] * u[base + s];
+            out[j] = acc;
+        }
+    });
+}
+
+uint32_t tai::NcoMix(Pool& pool, const float* in, uint32_t len, uint32_t phase, uint32_t step,
+                     std::complex<float>* out) {
+    const double cycle = 2.0 * M_PI / 4294967296.0;
+
+    // Rotation of j samples inside a block, applied to the block's exact start phasor.
+    float rot_re[NcoBlock], rot_im[NcoBlock];
+    for (uint32_t j = 0; j != NcoBlock; ++j) {
+        const double a = cycle * static_cast<uint32_t>(j * step);
+        rot_re[j] = static_cast<float>(std::cos(a));
+        rot_im[j] = static_cast<float>(-std::sin(a));
+    }
+
+    const uint32_t blocks = (len + NcoBlock - 1) / NcoBlock;
+    const uint32_t per_task = 64;
+    pool.ParallelFor((blocks + per_task - 1) / per_task, [&](uint32_t t) {
+        const uint32_t end = std::min(blocks, (t + 1) * per_task);
+        for (uint32_t b = t * per_task; b < end; ++b) {
+            const uint32_t first = b * NcoBlock;
+            const uint32_t cnt = std::min(NcoBlock, len - first);
+            const double a = cycle * static_cast<uint32_t>(phase + static_cast<uint64_t>(first) * step);
+            const float c = static_cast<float>(std::cos(a)), s = static_cast<float>(-std::sin(a));
+            const float* x = in + first;
+            float* y = reinterpret_cast<float*>(out + first);
+            for (uint32_t j = 0; j < cnt; ++j) {
+                y[2 * j] = x[j] * (c * rot_re[j] - s * rot_im[j]);
+                y[2 * j + 1] = x[j] * (c * rot_im[j] + s * rot_re[j]);
+            }
+        }
+    });
+    return static_cast<uint32_t>(phase + static_cast<uint64_t>(len) * step);
+}
+
+void tai::Fft2d(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, std::complex<float>* out,
+                uint32_t rows, uint32_t cols, FftDir dir) {
+    if (rows == 0 || cols == 0) return;
+    auto row_plan = plans.Get<float>(cols, dir);
+    auto col_plan = plans.Get<float>(rows, dir);
+
+    const uint32_t per_task = std::max(1u, rows / (pool.Size() * 4));
+    pool.ParallelFor((rows + per_task - 1) / per_task, [&](uint32_t t) {
+        const uint32_t end = std::min(rows, (t + 1) * per_task);
+        for (uint32_t r = t * per_task; r < end; ++r) {
+            row_plan->Execute(in + static_cast<size_t>(r) * cols, out + static_cast<size_t>(r) * cols);
+        }
+    });
+
+    ColumnPass(pool, *col_plan, out, rows, cols);
+}
+
+void tai::FourStepFft(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, std::complex<float>* out,
+                      uint32_t n, FftDir dir) {
+    const uint32_t n1 = SmallFactor(n);
+    if (n1 == 0) {
+        plans.Get<float>(n, dir)->Execute(in, out);
+        return;
+    }
+    const uint32_t n2 = n / n1;
+    auto short_plan = plans.Get<float>(n1, dir);
+    auto long_plan = plans.Get<float>(n2, dir);
+
+    // Twiddle w^m for m = j * k < n as coarse[m / n2] * fine[m % n2], two tables of n1 + n2.
+    const double sign = dir == FftDir::Forward ? -1.0 : 1.0;
+    std::vector<std::complex<float>> coarse(n1), fine(n2);
+    for (uint32_t a = 0; a != n1; ++a) {
+        const double t = sign * 2.0 * M_PI * a / n1;
+        coarse[a] = {static_cast<float>(std::cos(t)), static_cast<float>(std::sin(t))};
+    }
+    for (uint32_t b = 0; b != n2; ++b) {
+        const double t = sign * 2.0 * M_PI * b / n;
+        fine[b] = {static_cast<float>(std::cos(t)), static_cast<float>(std::sin(t))};
+    }
+
+    std::vector<std::complex<float>> copy;
+    if (in == out) {
+        copy.assign(in, in + n);
+        in = copy.data();
+    }
+
+    // With x[j + n1 * i] and X[n2 * k1 + k], column j of the n2 x n1 input goes through an
+    // n2-point transform, is twiddled by w^(j * k) and becomes row j of out, then every
+    // column of the n1 x n2 result goes through an n1-point transform in place.
+    pool.ParallelFor((n1 + ColumnTile - 1) / ColumnTile, [&](uint32_t t) {
+        static thread_local std::vector<std::complex<float>> buf;
+        const uint32_t c0 = t * ColumnTile;
+        const uint32_t w = std::min(ColumnTile, n1 - c0);
+        buf.resize(static_cast<size_t>(w) * n2);
+
+        for (uint32_t r = 0; r < n2; ++r) {
+            const std::complex<float>* src = in + static_cast<size_t>(r) * n1 + c0;
+            for (uint32_t b = 0; b < w; ++b) buf[static_cast<size_t>(b) * n2 + r] = src[b];
+        }
+        for (uint32_t b = 0; b < w; ++b) {
+            const uint32_t j = c0 + b;
+            std::complex<float>* dst = out + static_cast<size_t>(j) * n2;
+            long_plan->Execute(buf.data() + static_cast<size_t>(b) * n2, dst);
+
+            uint32_t hi = 0, lo = 0;
+            for (uint32_t k = 0; k < n2; ++k) {
+                dst[k] = Mul(dst[k], Mul(coarse[hi], fine[lo]));
+                lo += j;
+                if (lo >= n2) {
+                    lo -= n2;
+                    ++hi;
+                }
+            }
+        }
+    });
+
+    ColumnPass(pool, *short_plan, out, n1, n2);
+}
+
+void tai::PrunedFft(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, uint32_t n,
+                    uint32_t first, uint32_t stride, uint32_t count, std::complex<float>* out) {
+    if (n == 0 || count == 0) return;
+    if (stride == 0) stride = 1;
+    first %= n;
+    stride %= n;
+
+    // Bins repeat every n / gcd(n, stride) steps; only the distinct ones are computed.
+    uint32_t period = n;
+    if (stride == 0) {
+        period = 1;
+    } else if (n % stride == 0) {
+        period = n / stride;
+    }
+    const uint32_t distinct = std::min(count, period);
+    const bool folds = stride == 0 || n % stride == 0;
+
+    const uint32_t m = folds ? period : n;
+    double pruned;
+    const uint32_t l = RangeFactor(m, folds ? distinct : m, &pruned);
+    if (folds && m != n) pruned += n;
+    const double goertzel = GoertzelCostFactor * distinct * n;
+
+    if (goertzel < pruned) {
+        pool.ParallelFor(distinct, [&](uint32_t i) {
+            out[i] = Goertzel(in, n, static_cast<uint32_t>((first + static_cast<uint64_t>(i) * stride) % n));
+        });
+    } else if (folds) {
+        // With first = q * s + e, X[first + s * i] is bin q + i of the m-point transform of
+        // y[a] = exp(-2 pi i a e / n) sum_b x[a + m b] exp(-2 pi i b e / s).
+        const uint32_t s = n / m;
+        const uint32_t q = first / s, e = first % s;
+        std::vector<std::complex<float>> y(in, in + m);
+        if (s > 1) {
+            std::vector<double> fold_re(s), fold_im(s);
+            for (uint32_t b = 0; b != s; ++b) {
+                const double a = -2.0 * M_PI * static_cast<double>((static_cast<uint64_t>(b) * e) % s) / s;
+                fold_re[b] = std::cos(a);
+                fold_im[b] = std::sin(a);
+            }
+            const double step = -2.0 * M_PI * e / n;
+            const uint32_t per_task = 4096;
+            pool.ParallelFor((m + per_task - 1) / per_task, [&](uint32_t t) {
+                const uint32_t begin = t * per_task, end = std::min(m, begin + per_task);
+                // The modulation is rebuilt exactly at every task start and rotated from there.
+                double wr = std::cos(step * begin), wi = std::sin(step * begin);
+                const double c = std::cos(step), sn = std::sin(step);
+                for (uint32_t a = begin; a < end; ++a) {
+                    double accr = 0, acci = 0;
+                    for (uint32_t b = 0; b != s; ++b) {
+                        const std::complex<float> v = in[a + static_cast<size_t>(m) * b];
+                        accr += v.real() * fold_re[b] - v.imag() * fold_im[b];
+                        acci += v.real() * fold_im[b] + v.imag() * fold_re[b];
+                    }
+                    y[a] = {static_cast<float>(accr * wr - acci * wi), static_cast<float>(accr * wi + acci * wr)};
+                    const double t0 = wr * c - wi * sn;
+                    wi = wr * sn + wi * c;
+                    wr = t0;
+                }
+            });
+        }
+        FftRange(plans, pool, y.data(), m, l, q, distinct, out);
+    } else {
+        // Scattered bins: one full transform.
+        std::vector<std::complex<float>> full(n);
+        plans.Get<float>(n, FftDir::Forward)->Execute(in, full.data());
+        for (uint32_t i = 0; i < distinct; ++i) {
+            out[i] = full[(first + static_cast<uint64_t>(i) * stride) % n];
+        }
+    }
+    for (uint32_t i = distinct; i < count; ++i) out[i] = out[i - distinct];
+}
+
+void tai::ChirpZ(FftPlanCache& plans, Pool& pool, const std::complex<float>* in, uint32_t n,
+                 uint64_t start, uint64_t step, uint32_t m, std::complex<float>* out) {
+    if (m == 0) return;
+    if (n == 0) {
+        std::fill(out, out + m, std::complex<float>(0));
+        return;
+    }
+    // With j k = (j^2 + k^2 - (k - j)^2) / 2, out[k] = c[k] sum_j (in[j] a[j] c[j]) conj(c[k - j])
+    // where c[j] = exp(-2 pi i step j^2 / 2^65) and a[j] = exp(-2 pi i start j / 2^64).
+    const uint64_t total = static_cast<uint64_t>(n) + m - 1;
+    uint32_t len = 1;
+    while (len < total) len <<= 1;
+    auto fwd = plans.Get<float>(len, FftDir::Forward);
+    auto inv = plans.Get<float>(len, FftDir::Inverse);
+    using u128 = unsigned __int128;
+
+    std::vector<std::complex<float>> y(len), v(len);
+    const uint32_t chunk = 4096;
+    pool.ParallelFor((len + chunk - 1) / chunk, [&](uint32_t t) {
+        const uint32_t end = std::min<uint32_t>(len, (t + 1) * chunk);
+        for (uint32_t j = t * chunk; j < end; ++j) {
+            if (j < n) {
+                y[j] = Mul(in[j], Cycle65(2 * static_cast<u128>(start) * j + static_cast<u128>(step) * j * j));
+            } else {
+                y[j] = 0;
+            }
+            // v[j] = conj(c[j]) for lags 0 .. m - 1, v[len - j] = conj(c[j]) for lags -(n - 1) .. -1
+            const uint32_t lag = j < m ? j : len - j;
+            if (j < m || (j > len - n)) {
+                v[j] = std::conj(Cycle65(static_cast<u128>(step) * lag * lag));
+            } else {
+                v[j] = 0;
+            }
+        }
+    });
+
+    fwd->Execute(y.data(), y.data());
+    fwd->Execute(v.data(), v.data());
+    Simd().mul_c32(reinterpret_cast<const float*>(y.data()), reinterpret_cast<const float*>(v.data()),
+                   reinterpret_cast<float*>(y.data()), len);
+    inv->Execute(y.data(), y.data());
+
+    pool.ParallelFor((m + chunk - 1) / chunk, [&](uint32_t t) {
+        const uint32_t end = std::min(m, (t + 1) * chunk);
+        for (uint32_t k = t * chunk; k < end; ++k) {
+            out[k] = Mul(y[k], Cycle65(static_cast<u128>(step) * k * k));
+        }
+    });
+}
+
+void tai::ChanStateInit(ChanState* st, const float* taps, uint32_t n, uint32_t channels) {
+    st->channels = channels;
+    st->taps = n;
+    st->fill = 0;
+    st->reserved = 0;
+    std::copy(taps, taps + n, st->Coef());
+    if (n > 0 && channels > 0) std::fill(st->History(), st->History() + n - 1, std::complex<float>(0));
+}
+
+uint32_t tai::Channelize(FftPlanCache& plans, Pool& pool, ChanState* st, const std::complex<float>* in,
+                         uint32_t len, std::complex<float>* out) {
+    const uint32_t k = st->channels, t = st->taps;
+    if (k == 0 || t == 0) return 0;
+    const uint32_t hist = t - 1;
+    const uint32_t held = hist + st->fill;
+    const uint32_t frames = static_cast<uint32_t>((static_cast<uint64_t>(st->fill) + len) / k);
+    const float* h = st->Coef();
+
+    // History, the unfinished frame and the new block, so every frame sees a full window.
+    static thread_local std::vector<std::complex<float>> ext;
+    ext.resize(static_cast<size_t>(held) + len);
+    std::copy(st->History(), st->History() + held, ext.begin());
+    std::copy(in, in + len, ext.begin() + held);
+
+    auto plan = plans.Get<float>(k, FftDir::Forward);
+    const uint32_t per_task = std::max(1u, 4096 / k);
+    pool.ParallelFor((frames + per_task - 1) / per_task, [&](uint32_t task) {
+        static thread_local std::vector<std::complex<float>> u;
+        u.resize(k);
+        const uint32_t end = std::min(frames, (task + 1) * per_task);
+        for (uint32_t f = task * per_task; f < end; ++f) {
+            // Branch r sums h[pK + r] x[newest - pK - r] over p.
+            const std::complex<float>* x = ext.data() + hist + static_cast<size_t>(f) * k + k - 1;
+            std::fill(u.begin(), u.end(), std::complex<float>(0));
+            for (uint32_t base = 0; base < t; base += k) {
+                const uint32_t cnt = std::min(k, t - base);
+                const float* hp = h + base;
+                const std::complex<float>* xp = x - base;
+                for (uint32_t r = 0; r < cnt; ++r) u[r] += hp[r] * xp[-int64_t(r)];
+            }
+            // sum_r u[r] exp(2 pi i k r / K) is the forward transform of u[-r mod K].
+            std::reverse(u.begin() + 1, u.end());
+            plan->Execute(u.data(), out + static_cast<size_t>(f) * k);
+        }
+    });
+
+    const uint32_t rest = static_cast<uint32_t>(static_cast<uint64_t>(st->fill) + len - static_cast<uint64_t>(frames) * k);
+    std::copy(ext.end() - (hist + rest), ext.end(), st->History());
+    st->fill = rest;
+    return frames;
+}
+
+void tai::FftProfile::Record(uint64_t n, uint64_t ns) {
+    len = n;
+    nsec = ns;
+    gflops = ns ? 5.0 * n * std::log2(static_cast<double>(std::max<uint64_t>(n, 2))) / ns : 0.0;
+}
+
+void tai::MatchedFilterPrep(FftPlanCache& plans, Pool& pool, const std::complex<float>* tmpl, uint32_t tlen,
+                            uint64_t stride, uint32_t count, uint32_t n, std::complex<float>* spectra) {
+    if (n == 0 || count == 0) return;
+    tlen = std::min(tlen, n);
+    auto plan = plans.Get<float>(n, FftDir::Forward);
+
+    pool.ParallelFor(count, [&](uint32_t r) {
+        std::complex<float>* row = spectra + static_cast<size_t>(r) * n;
+        const std::complex<float>* src = tmpl + r * stride;
+        std::copy(src, src + tlen, row);
+        std::fill(row + tlen, row + n, std::complex<float>(0));
+        plan->Execute(row, row);
+        Simd().conj_c32(reinterpret_cast<const float*>(row), reinterpret_cast<float*>(row), n);
+    });
+}
+
+void tai::MatchedFilterBank(FftPlanCache& plans, Pool& pool, const std::complex<float>* in,
+                            const std::complex<float>* spectra, uint32_t n, uint32_t count,
+                            std::complex<float>* out) {
+    if (n == 0 || count == 0) return;
+    auto fwd = plans.Get<float>(n, FftDir::Forward);
+    auto inv = plans.Get<float>(n, FftDir::Inverse);
+
+    std::vector<std::complex<float>> x(n);
+    fwd->Execute(in, x.data());
+    auto xp = reinterpret_cast<const float*>(x.data());
+
+    const uint32_t rows = std::max(1u, count / (pool.Size() * 4));
+    pool.ParallelFor((count + rows - 1) / rows, [&](uint32_t t) {
+        const uint32_t end = std::min(count, (t + 1) * rows);
+        for (uint32_t r = t * rows; r < end; ++r) {
+            std::complex<float>* row = out + static_cast<size_t>(r) * n;
+            Simd().mul_c32(xp, reinterpret_cast<const float*>(spectra + static_cast<size_t>(r) * n),
+                           reinterpret_cast<float*>(row), n);
+            inv->Execute(row, row);
+        }
+    });
+}
+
+std::shared_ptr<const std::vector<float>> tai::WindowCache::Get(Window type, uint32_t n) {
+    // Cosine sum coefficients a0, a1, a2, a3 of each window.
+    static const std::map<Window, std::vector<double>> sums = {
+        {Window::Hann, {0.5, 0.5}},
+        {Window::Hamming, {0.54, 0.46}},
+        {Window::Blackman, {0.42, 0.5, 0.08}},
+        {Window::BlackmanHarris, {0.35875, 0.48829, 0.14128, 0.01168}},
+    };
+    auto coef = sums.find(type);
+    if (coef == sums.end() || n == 0) return nullptr;
+
+    const auto key = std::make_pair(static_cast<uint32_t>(type), n);
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto iter = tables_.find(key);
+    if (iter != tables_.end()) return iter->second;
+
+    auto table = std::make_shared<std::vector<float>>(n);
+    for (uint32_t i = 0; i != n; ++i) {
+        double v = 0, sign = 1;
+        for (size_t k = 0; k != coef->second.size(); ++k, sign = -sign) {
+            v += sign * coef->second[k] * std::cos(2.0 * M_PI * k * i / n);
+        }
+        (*table)[i] = static_cast<float>(v);
+    }
+    tables_.emplace(key, table);
+    return table;
+}
+
+namespace tai {
+    template void FastConv<float, float>(FftPlanCache&, Pool&, const float*, uint32_t,
+                                         const float*, uint32_t, float*);
+    template void FastConv<int32_t, double>(FftPlanCache&, Pool&, const int32_t*, uint32_t,
+                                            const int32_t*, uint32_t, int32_t*);
+}  // namespace tai
@@ -0,0 +1,436 @@
+#include <cmath>
+#include <algorithm>
+#include "../include/tai_fft.h"
+#include "../include/tai_simd.h"
+
+using namespace tai;
+
+namespace {
+
+    // Complex product without the NaN/Inf recovery of operator*.
+    template <typename T>
+    inline std::complex<T> Mul(const std::complex<T>& a, const std::complex<T>& b) {
+        return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+    }
+
+    // Multiply by sign * i, sign is -1 for the forward transform.
+    template <typename T>
+    inline std::complex<T> Rot(const std::complex<T>& a, T sign) {
+        return {-sign * a.imag(), sign * a.real()};
+    }
+
+    // exp(sign * 2 * pi * i * num / den), with num reduced first so large products stay exact.
+    template <typename T>
+    std::complex<T> Root(uint64_t num, uint64_t den, T sign) {
+        const double a = 2.0 * M_PI * static_cast<double>(num % den) / static_cast<double>(den);
+        return {static_cast<T>(cos(a)), static_cast<T>(sign * sin(a))};
+    }
+
+    // Slot 0 for in-place permutes, 1 for Bluestein, 2 for callers wrapping a plan.
+    template <typename T>
+    std::vector<std::complex<T>>& Scratch(int slot) {
+        static thread_local std::vector<std::complex<T>> buf[3];
+        return buf[slot];
+    }
+
+    template <typename T>
+    inline void Radix4(std::complex<T>& a0, std::complex<T>& a1, std::complex<T>& a2,
+                       std::complex<T>& a3, T sign) {
+        auto t0 = a0 + a2;
+        auto t1 = a0 - a2;
+        auto t2 = a1 + a3;
+        auto t3 = Rot(a1 - a3, sign);
+        a0 = t0 + t2;
+        a1 = t1 + t3;
+        a2 = t0 - t2;
+        a3 = t1 - t3;
+    }
+
+}  // namespace
+
+template <typename T>
+struct FftPlan<T>::Chirp {
+    uint32_t m;
+    std::vector<Complex> w;         // exp(sign * i * pi * k^2 / n)
+    std::vector<Complex> kernel;    // forward transform of conj(w), wrapped to length m
+    std::unique_ptr<FftPlan> fwd;
+    std::unique_ptr<FftPlan> inv;
+};
+
+template <typename T>
+FftPlan<T>::FftPlan(uint32_t n, FftDir dir) : n_(n), dir_(dir) {
+    scale_ = (dir_ == FftDir::Inverse && n_ != 0) ? T(1) / static_cast<T>(n_) : T(1);
+    Factorize();
+}
+
+template <typename T>
+FftPlan<T>::~FftPlan() = default;
+
+template <typename T>
+void FftPlan<T>::Factorize() {
+    if (n_ <= 1) return;
+    const T sign = (dir_ == FftDir::Forward) ? T(-1) : T(1);
+
+    std::vector<uint32_t> radices;
+    uint32_t rest = n_;
+    while (rest % 8 == 0) {
+        radices.push_back(8);
+        rest /= 8;
+    }
+    if (rest % 4 == 0) {
+        radices.push_back(4);
+        rest /= 4;
+    } else if (rest % 2 == 0) {
+        radices.push_back(2);
+        rest /= 2;
+    }
+    for (uint32_t p = 3; p <= FftMaxRadix; p += 2) {
+        while (rest % p == 0) {
+            radices.push_back(p);
+            rest /= p;
+        }
+    }
+
+    if (rest != 1) {
+        // Bluestein: x_k * w_k convolved with conj(w), evaluated with a power-of-two FFT.
+        auto c = std::unique_ptr<Chirp>(new Chirp);
+        c->m = 1;
+        while (c->m < 2 * n_ - 1) c->m <<= 1;
+        c->fwd.reset(new FftPlan(c->m, FftDir::Forward));
+        c->inv.reset(new FftPlan(c->m, FftDir::Inverse));
+        c->w.resize(n_);
+        for (uint64_t k = 0; k != n_; ++k) {
+            c->w[k] = Root<T>(k * k, 2ull * n_, sign);
+        }
+        c->kernel.assign(c->m, Complex(0));
+        c->kernel[0] = std::conj(c->w[0]);
+        for (uint32_t k = 1; k != n_; ++k) {
+            c->kernel[k] = c->kernel[c->m - k] = std::conj(c->w[k]);
+        }
+        c->fwd->Execute(c->kernel.data(), c->kernel.data());
+        bluestein_ = std::move(c);
+        return;
+    }
+
+    uint32_t span = 1;
+    for (auto r : radices) {
+        Stage s;
+        s.radix = r;
+        s.span = span;
+        const uint32_t len = r * span;
+        if (span > 1) {
+            s.tw.resize(static_cast<size_t>(span) * (r - 1));
+            for (uint32_t k = 0; k != span; ++k) {
+                for (uint32_t j = 1; j != r; ++j) {
+                    s.tw[k * (r - 1) + j - 1] = Root<T>(static_cast<uint64_t>(j) * k, len, sign);
+                }
+            }
+        }
+        if (r != 2 && r != 3 && r != 4 && r != 8) {
+            s.roots.resize(r);
+            for (uint32_t q = 0; q != r; ++q) s.roots[q] = Root<T>(q, r, sign);
+        }
+        stages_.push_back(std::move(s));
+        span = len;
+    }
+
+    // The last stage combines sub transforms of x[j + r * t], so peel digits from the last radix.
+    perm_.resize(n_);
+    for (uint32_t i = 0; i != n_; ++i) {
+        uint32_t p = 0, rem = i, size = n_;
+        for (auto s = stages_.size(); s-- > 0;) {
+            const uint32_t r = stages_[s].radix;
+            size /= r;
+            p += (rem % r) * size;
+            rem /= r;
+        }
+        perm_[p] = i;
+    }
+}
+
+template <typename T>
+void FftPlan<T>::Permute(const Complex* in, Complex* out, const T* window) const {
+    const uint32_t* perm = perm_.data();
+    if (window) {
+        for (uint32_t i = 0; i != n_; ++i) {
+            out[i] = in[perm[i]] * window[perm[i]];
+        }
+        return;
+    }
+    for (uint32_t i = 0; i != n_; ++i) {
+        out[i] = in[perm[i]];
+    }
+}
+
+template <typename T>
+void FftPlan<T>::Butterflies(Complex* x) const {
+    const T sign = (dir_ == FftDir::Forward) ? T(-1) : T(1);
+    const T h = static_cast<T>(M_SQRT1_2);
+    const T s3 = static_cast<T>(0.86602540378443864676);
+
+    for (auto& st : stages_) {
+        const uint32_t r = st.radix;
+        const uint32_t m = st.span;
+        const uint32_t len = r * m;
+        const Complex* tw = st.tw.data();
+        Complex a[FftMaxRadix > 8 ? FftMaxRadix : 8];
+
+        for (uint32_t b = 0; b < n_; b += len) {
+            for (uint32_t k = 0; k != m; ++k) {
+                Complex* p = x + b + k;
+                a[0] = p[0];
+                if (m == 1) {
+                    for (uint32_t j = 1; j != r; ++j) a[j] = p[j];
+                } else {
+                    const Complex* t = tw + k * (r - 1);
+                    for (uint32_t j = 1; j != r; ++j) a[j] = Mul(p[j * m], t[j - 1]);
+                }
+
+                switch (r) {
+                    case 2: {
+                        p[0] = a[0] + a[1];
+                        p[m] = a[0] - a[1];
+                        break;
+                    }
+                    case 3: {
+                        auto t1 = a[1] + a[2];
+                        auto t2 = a[0] - t1 * T(0.5);
+                        auto t3 = Rot((a[1] - a[2]) * s3, sign);
+                        p[0] = a[0] + t1;
+                        p[m] = t2 + t3;
+                        p[2 * m] = t2 - t3;
+                        break;
+                    }
+                    case 4: {
+                        Radix4(a[0], a[1], a[2], a[3], sign);
+                        p[0] = a[0];
+                        p[m] = a[1];
+                        p[2 * m] = a[2];
+                        p[3 * m] = a[3];
+                        break;
+                    }
+                    case 8: {
+                        Radix4(a[0], a[2], a[4], a[6], sign);
+                        Radix4(a[1], a[3], a[5], a[7], sign);
+                        // odd half times W8^q, W8 = (1 + sign * i) / sqrt(2)
+                        auto o1 = Complex((a[3].real() - sign * a[3].imag()) * h,
+                                          (a[3].imag() + sign * a[3].real()) * h);
+                        auto o2 = Rot(a[5], sign);
+                        auto o3 = Complex((-a[7].real() - sign * a[7].imag()) * h,
+                                          (sign * a[7].real() - a[7].imag()) * h);
+                        p[0] = a[0] + a[1];
+                        p[4 * m] = a[0] - a[1];
+                        p[m] = a[2] + o1;
+                        p[5 * m] = a[2] - o1;
+                        p[2 * m] = a[4] + o2;
+                        p[6 * m] = a[4] - o2;
+                        p[3 * m] = a[6] + o3;
+                        p[7 * m] = a[6] - o3;
+                        break;
+                    }
+                    default: {
+                        const Complex* w = st.roots.data();
+                        for (uint32_t q = 0; q != r; ++q) {
+                            Complex acc = a[0];
+                            for (uint32_t j = 1, e = q; j != r; ++j, e = (e + q) % r) {
+                                acc += Mul(a[j], w[e]);
+                            }
+                            p[q * m] = acc;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void FftPlan<T>::ExecuteBluestein(const Complex* in, Complex* out, const T* window) const {
+    const Chirp& c = *bluestein_;
+    auto& buf = Scratch<T>(1);
+    buf.resize(c.m);
+    for (uint32_t k = 0; k != n_; ++k) buf[k] = Mul(in[k], c.w[k]);
+    if (window) {
+        for (uint32_t k = 0; k != n_; ++k) buf[k] *= window[k];
+    }
+    std::fill(buf.begin() + n_, buf.end(), Complex(0));
+    c.fwd->Execute(buf.data(), buf.data());
+    for (uint32_t k = 0; k != c.m; ++k) buf[k] = Mul(buf[k], c.kernel[k]);
+    c.inv->Execute(buf.data(), buf.data());
+    for (uint32_t k = 0; k != n_; ++k) out[k] = Mul(buf[k], c.w[k]) * scale_;
+}
+
+template <typename T>
+void FftPlan<T>::Execute(const Complex* in, Complex* out) const {
+    Execute(in, out, nullptr);
+}
+
+template <typename T>
+void FftPlan<T>::Execute(const Complex* in, Complex* out, const T* window) const {
+    if (n_ == 0) return;
+    if (n_ == 1) {
+        out[0] = window ? in[0] * window[0] : in[0];
+        return;
+    }
+    if (bluestein_) {
+        ExecuteBluestein(in, out, window);
+        return;
+    }
+    if (in == out) {
+        auto& buf = Scratch<T>(0);
+        buf.assign(in, in + n_);
+        Permute(buf.data(), out, window);
+    } else {
+        Permute(in, out, window);
+    }
+    Butterflies(out);
+    if (dir_ == FftDir::Inverse) {
+        for (uint32_t i = 0; i != n_; ++i) out[i] *= scale_;
+    }
+}
+
+template <typename T>
+RfftPlan<T>::RfftPlan(uint32_t n) : n_(n) {
+    if (n_ % 2 == 0) {
+        const uint32_t h = n_ / 2;
+        fwd_.reset(new FftPlan<T>(h, FftDir::Forward));
+        inv_.reset(new FftPlan<T>(h, FftDir::Inverse));
+        tw_.resize(h / 2 + 1);
+        for (uint32_t k = 0; k != tw_.size(); ++k) tw_[k] = Root<T>(k, n_, T(-1));
+    } else {
+        fwd_.reset(new FftPlan<T>(n_, FftDir::Forward));
+        inv_.reset(new FftPlan<T>(n_, FftDir::Inverse));
+    }
+}
+
+template <typename T>
+void RfftPlan<T>::Forward(const T* in, Complex* out) const {
+    if (n_ == 0) return;
+    if (n_ % 2 != 0) {
+        auto& buf = Scratch<T>(2);
+        buf.assign(in, in + n_);
+        fwd_->Execute(buf.data(), buf.data());
+        std::copy(buf.begin(), buf.begin() + n_ / 2 + 1, out);
+        return;
+    }
+
+    // z[k] = x[2k] + i * x[2k+1] is the input itself read as complex.
+    const uint32_t h = n_ / 2;
+    fwd_->Execute(reinterpret_cast<const Complex*>(in), out);
+
+    const T z0r = out[0].real(), z0i = out[0].imag();
+    out[0] = Complex(z0r + z0i, 0);
+    out[h] = Complex(z0r - z0i, 0);
+    // X[k] = E[k] + W^k * O[k] with E, O the transforms of the even and odd samples,
+    // and X[h - k] uses the same pair with W^(h - k) = -conj(W^k).
+    for (uint32_t k = 1; k <= h / 2; ++k) {
+        const Complex a = out[k], b = std::conj(out[h - k]);
+        const Complex e = (a + b) * T(0.5);
+        const Complex o = Mul(Rot(a - b, T(-1)) * T(0.5), tw_[k]);
+        out[k] = e + o;
+        out[h - k] = std::conj(e - o);
+    }
+}
+
+template <typename T>
+void RfftPlan<T>::Inverse(const Complex* in, T* out) const {
+    if (n_ == 0) return;
+    if (n_ % 2 != 0) {
+        auto& buf = Scratch<T>(2);
+        buf.resize(n_);
+        buf[0] = Complex(in[0].real(), 0);
+        for (uint32_t k = 1; k <= n_ / 2; ++k) {
+            buf[k] = in[k];
+            buf[n_ - k] = std::conj(in[k]);
+        }
+        inv_->Execute(buf.data(), buf.data());
+        for (uint32_t i = 0; i != n_; ++i) out[i] = buf[i].real();
+        return;
+    }
+
+    // Rebuild z = E + i * O pairwise, so out may overlap in.
+    const uint32_t h = n_ / 2;
+    auto z = reinterpret_cast<Complex*>(out);
+    const T x0 = in[0].real(), xh = in[h].real();
+    for (uint32_t k = 1; k <= h / 2; ++k) {
+        const Complex a = in[k], b = std::conj(in[h - k]);
+        const Complex e = (a + b) * T(0.5);
+        const Complex o = Mul(a - b, std::conj(tw_[k])) * T(0.5);
+        z[k] = e + Rot(o, T(1));
+        z[h - k] = std::conj(e - Rot(o, T(1)));
+    }
+    z[0] = Complex((x0 + xh) * T(0.5), (x0 - xh) * T(0.5));
+    inv_->Execute(z, z);
+}
+
+FftI16Plan::FftI16Plan(uint32_t n, FftDir dir) : n_(n), dir_(dir), stages_(0) {
+    if (!Supported(n_)) return;
+    while ((1u << stages_) < n_) ++stages_;
+
+    perm_.resize(n_);
+    for (uint32_t i = 0; i != n_; ++i) {
+        uint32_t r = 0;
+        for (uint32_t b = 0; b != stages_; ++b) r |= ((i >> b) & 1u) << (stages_ - 1 - b);
+        perm_[i] = r;
+    }
+
+    // Q15 twiddles, +-1 saturate to +-32767.
+    const double sign = (dir_ == FftDir::Forward) ? -1.0 : 1.0;
+    auto q15 = [](double v) {
+        return static_cast<int16_t>(std::max(-32767.0, std::min(32767.0, std::round(v * 32768.0))));
+    };
+    tw_re_.resize(n_ > 1 ? 2 * (n_ - 1) : 0);
+    tw_im_.resize(tw_re_.size());
+    for (uint32_t h = 1; h < n_; h <<= 1) {
+        int16_t* re = tw_re_.data() + 2 * (h - 1);
+        int16_t* im = tw_im_.data() + 2 * (h - 1);
+        for (uint32_t k = 0; k != h; ++k) {
+            const double a = M_PI * k / h;
+            const int16_t wr = q15(std::cos(a)), wi = q15(sign * std::sin(a));
+            re[2 * k] = re[2 * k + 1] = wr;
+            im[2 * k] = static_cast<int16_t>(-wi);
+            im[2 * k + 1] = wi;
+        }
+    }
+}
+
+int32_t FftI16Plan::Execute(const int16_t* in, int16_t* out, int32_t* exps) const {
+    if (!Supported(n_)) return 0;
+    static thread_local std::vector<int16_t> copy;
+    if (in == out) {
+        copy.assign(in, in + 2 * n_);
+        in = copy.data();
+    }
+
+    for (uint32_t i = 0; i != n_; ++i) {
+        out[2 * i] = in[2 * perm_[i]];
+        out[2 * i + 1] = in[2 * perm_[i] + 1];
+    }
+    uint32_t peak = 0;
+    for (uint32_t i = 0; i != 2 * n_; ++i) {
+        const uint32_t v = out[i] < 0 ? -int32_t(out[i]) : out[i];
+        peak = v > peak ? v : peak;
+    }
+
+    // A butterfly grows a component by at most 1 + sqrt(2), keep the scaled peak below 32767 / 2.414.
+    const uint32_t limit = 13572;
+    const auto stage = Simd().fft_stage_i16;
+    int32_t exponent = 0;
+    for (uint32_t s = 0, h = 1; s != stages_; ++s, h <<= 1) {
+        int shift = 0;
+        while (((peak + ((1u << shift) >> 1)) >> shift) > limit) ++shift;
+        peak = stage(out, n_, h, tw_re_.data() + 2 * (h - 1), tw_im_.data() + 2 * (h - 1), shift);
+        if (exps) exps[s] = shift;
+        exponent += shift;
+    }
+    if (dir_ == FftDir::Inverse) exponent -= static_cast<int32_t>(stages_);
+    return exponent;
+}
+
+namespace tai {
+    template class RfftPlan<float>;
+    template class RfftPlan<double>;
+    template class FftPlan<float>;
+    template class FftPlan<double>;
+}  // namespace tai
@@ -0,0 +1,183 @@
+#include <cstdlib>
+#include <algorithm>
+#include <unistd.h>
+#include "../include/tai_gemm.h"
+#include "../include/tai_sim.h"
+#include "../include/tai_simd.h"
+
+using namespace tai;
+
+namespace {
+
+    // Cache sizes in bytes, from sysconf where the C library knows them.
+    struct Caches {
+        size_t l1 = 32 << 10;
+        size_t l2 = 1 << 20;
+        size_t l3 = 8 << 20;
+    };
+
+    const Caches& HostCaches() {
+        static const Caches caches = [] {
+            Caches c;
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+            long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE), l2 = sysconf(_SC_LEVEL2_CACHE_SIZE),
+                 l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+            if (l1 > 0) c.l1 = l1;
+            if (l2 > 0) c.l2 = l2;
+            if (l3 > 0) c.l3 = l3;
+#endif
+            return c;
+        }();
+        return caches;
+    }
+
+    // Widest b panel, in columns, whatever the L3 size.
+    constexpr size_t MaxNc = 8192;
+
+    size_t RoundUp(size_t x, size_t to) { return (x + to - 1) / to * to; }
+
+    // Packed panels, on cache line boundaries.
+    template <typename T>
+    struct Buffer {
+        explicit Buffer(size_t n) : p(static_cast<T*>(std::aligned_alloc(64, RoundUp(n * sizeof(T), 64)))) {}
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        ~Buffer() { std::free(p); }
+        T* p;
+    };
+
+    // Rows [row, row + rows) and columns [col, col + kc) of a (lda columns) as panels of mr rows,
+    // l-major within a panel, rows past the end zero.
+    template <typename T>
+    void PackA(const T* a, size_t lda, size_t row, size_t rows, size_t col, size_t kc, size_t mr, T* ap) {
+        for (size_t ir = 0; ir < rows; ir += mr) {
+            T* panel = ap + ir * kc;
+            for (size_t i = 0; i < mr; ++i) {
+                if (ir + i < rows) {
+                    const T* src = a + (row + ir + i) * lda + col;
+                    for (size_t l = 0; l < kc; ++l) {
+                        panel[l * mr + i] = src[l];
+                    }
+                } else {
+                    for (size_t l = 0; l < kc; ++l) {
+                        panel[l * mr + i] = T(0);
+                    }
+                }
+            }
+        }
+    }
+
+    // Panel p of nr columns of rows [row, row + kc) of b (ldb columns) from column col on,
+    // columns past cols zero.
+    template <typename T>
+    void PackB(const T* b, size_t ldb, size_t row, size_t kc, size_t col, size_t cols, size_t nr, T* bp) {
+        size_t w = std::min(nr, cols);
+        for (size_t l = 0; l < kc; ++l) {
+            const T* src = b + (row + l) * ldb + col;
+            T* dst = bp + l * nr;
+            std::copy(src, src + w, dst);
+            std::fill(dst + w, dst + nr, T(0));
+        }
+    }
+
+    template <typename T>
+    void Blocked(Pool& pool, uint32_t threads, const SimdKernels::Gemm<T>& ukr, const T* a, const T* b, T* c,
+                 size_t m, size_t k, size_t n) {
+        if (m == 0 || n == 0) return;
+        if (k == 0) {
+            std::fill(c, c + m * n, T(0));
+            return;
+        }
+        const size_t mr = ukr.mr, nr = ukr.nr;
+        const Caches& caches = HostCaches();
+        threads = std::max<uint32_t>(1, std::min(threads, pool.Size()));
+
+        // A b panel of kc x nr fills half of L1, an a block of mc x kc half of L2 and the
+        // packed b of kc x nc half of L3. mc is cut down until every thread has a block of rows.
+        size_t kc = std::min(k, std::max<size_t>(16, caches.l1 / 2 / (nr * sizeof(T)) / 8 * 8));
+        size_t mc = std::max(mr, caches.l2 / 2 / (kc * sizeof(T)) / mr * mr);
+        mc = std::min({mc, RoundUp(m, mr), RoundUp((m + threads - 1) / threads, mr)});
+        size_t nc = std::max(nr, std::min(MaxNc, caches.l3 / 2 / (kc * sizeof(T))) / nr * nr);
+        nc = std::min(nc, RoundUp(n, nr));
+
+        // Threads too many for the row blocks split the nr panels of each macro-tile as well.
+        const size_t row_blocks = (m + mc - 1) / mc;
+        const size_t max_groups = nc / nr;
+        const size_t groups = std::min(max_groups, std::max<size_t>(1, (threads + row_blocks - 1) / row_blocks));
+        const size_t items = row_blocks * groups;
+        const uint32_t slots = static_cast<uint32_t>(std::min<size_t>(threads, items));
+
+        Buffer<T> bp(kc * nc);
+        Buffer<T> ap(slots * mc * kc);
+
+        for (size_t jc = 0; jc < n; jc += nc) {
+            const size_t ncur = std::min(nc, n - jc);
+            const size_t panels = (ncur + nr - 1) / nr;
+            for (size_t pc = 0; pc < k; pc += kc) {
+                const size_t kcur = std::min(kc, k - pc);
+                const bool accumulate = pc != 0;
+
+                auto pack = [&](uint32_t p) {
+                    PackB(b, n, pc, kcur, jc + p * nr, ncur - p * nr, nr, bp.p + p * nr * kcur);
+                };
+                if (slots > 1) {
+                    pool.ParallelFor(static_cast<uint32_t>(panels), pack);
+                } else {
+                    for (uint32_t p = 0; p < panels; ++p) pack(p);
+                }
+
+                auto run = [&](uint32_t slot) {
+                    T* my_ap = ap.p + slot * mc * kc;
+                    T edge[32 * 32];
+                    for (size_t item = slot; item < items; item += slots) {
+                        const size_t ic = item / groups * mc, group = item % groups;
+                        const size_t mcur = std::min(mc, m - ic);
+                        const size_t first = panels * group / groups, last = panels * (group + 1) / groups;
+                        if (first == last) continue;
+                        PackA(a, k, ic, mcur, pc, kcur, mr, my_ap);
+                        for (size_t jr = first; jr < last; ++jr) {
+                            const T* bpanel = bp.p + jr * nr * kcur;
+                            const size_t col = jc + jr * nr, w = std::min(nr, n - col);
+                            for (size_t ir = 0; ir < mcur; ir += mr) {
+                                const T* apanel = my_ap + ir * kcur;
+                                T* cblock = c + (ic + ir) * n + col;
+                                const size_t h = std::min(mr, mcur - ir);
+                                if (h == mr && w == nr) {
+                                    ukr.run(kcur, apanel, bpanel, cblock, n, accumulate);
+                                    continue;
+                                }
+                                ukr.run(kcur, apanel, bpanel, edge, nr, false);
+                                for (size_t i = 0; i < h; ++i) {
+                                    for (size_t j = 0; j < w; ++j) {
+                                        cblock[i * n + j] = accumulate ? cblock[i * n + j] + edge[i * nr + j] : edge[i * nr + j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                };
+                if (slots > 1) {
+                    pool.ParallelFor(slots, run);
+                } else {
+                    run(0);
+                }
+            }
+        }
+    }
+
+}  // namespace
+
+void tai::Gemm(Pool& pool, uint32_t threads, const float* a, const float* b, float* c,
+               uint32_t m, uint32_t k, uint32_t n) {
+    Blocked(pool, threads, Simd().gemm_f32, a, b, c, m, k, n);
+}
+
+void tai::Gemm(Pool& pool, uint32_t threads, const double* a, const double* b, double* c,
+               uint32_t m, uint32_t k, uint32_t n) {
+    Blocked(pool, threads, Simd().gemm_f64, a, b, c, m, k, n);
+}
+
+void tai::Gemm(Pool& pool, uint32_t threads, const int32_t* a, const int32_t* b, int32_t* c,
+               uint32_t m, uint32_t k, uint32_t n) {
+    Blocked(pool, threads, Simd().gemm_i32, a, b, c, m, k, n);
+}
@@ -1,14 +1,379 @@
 #include <iostream>
+#include <chrono>
 #include <algorithm>
 #include <math.h>
 #include <complex.h>
 #include "../include/tai_inst.h"
 #include "../include/tai_sim.h"
+#include "../include/tai_fft.h"
+#include "../include/tai_dsp.h"
+#include "../include/tai_gemm.h"
+#include "../include/tai_simd.h"
+#include "../include/tai_vec.h"
 
 using namespace tai;
 
 #define PI acos(-1)
 
+namespace {
+    // Elements per tile of a fused chain. Two tiles of the widest element (complex double)
+    // are kept in tmp_ and stay in L1/L2 between the stages.
+    constexpr uint32_t FuseTile = 2048;
+
+    // Vector instructions from VEC_PAR_MIN elements on are cut into VecChunk pieces, a few
+    // hundred KB of operands each. Slot s of the VEC_THREADS slots takes chunks s, s + slots, ...,
+    // so which elements go together never depends on timing.
+    constexpr uint32_t VecChunk = 1u << 14;
+    constexpr uint32_t VecParMin = 1u << 16;
+
+    // Slots for an instruction on len elements cut into the given number of pieces.
+    uint32_t Slots(Unit* c, uint64_t len, uint64_t pieces) {
+        uint64_t par_min = c->acc_->spec_reg_.Get(VEC_PAR_MIN);
+        if (par_min == 0) par_min = VecParMin;
+        uint64_t threads = c->acc_->spec_reg_.Get(VEC_THREADS);
+        if (threads == 0 || threads > c->acc_->pool_.Size()) threads = c->acc_->pool_.Size();
+        return len < par_min ? 1 : std::min<uint64_t>(threads, pieces);
+    }
+
+    // fn(slot, first, n) for pieces covering [0, len), spread over at most max_slots slots.
+    // Below the threshold fn sees the whole range at once in slot 0.
+    template <typename Fn>
+    void Chunked(Unit* c, uint64_t len, uint32_t max_slots, Fn fn) {
+        uint64_t chunks = (len + VecChunk - 1) / VecChunk;
+        uint32_t slots = std::min(Slots(c, len, chunks), max_slots);
+        if (slots <= 1) {
+            fn(0, 0, len);
+            return;
+        }
+        c->acc_->pool_.ParallelFor(slots, [&](uint32_t slot) {
+            for (uint64_t k = slot; k < chunks; k += slots) {
+                uint64_t first = k * VecChunk;
+                fn(slot, first, static_cast<uint32_t>(std::min<uint64_t>(VecChunk, len - first)));
+            }
+        });
+    }
+
+    // Layout of the operand with the given stride and index registers.
+    vec::Layout OperandLayout(Unit* c, SpecRegNames stride, SpecRegNames index) {
+        vec::Layout l;
+        l.stride = std::max<uint64_t>(1, c->acc_->spec_reg_.Get(stride));
+        l.index = reinterpret_cast<const uint32_t*>(c->acc_->spec_reg_.Get(index));
+        return l;
+    }
+
+    // Elements [first, first + n) of the operand at base: in place if it is packed, otherwise
+    // gathered into scratch.
+    template <typename T>
+    const T* Operand(const T* base, vec::Layout l, uint64_t first, uint32_t n, void* scratch) {
+        if (l.Packed()) return base + first;
+        vec::Gather(base, sizeof(T), l, first, n, scratch);
+        return static_cast<const T*>(scratch);
+    }
+
+    // Run chain (in execution order) over VLEN elements as one pass: every tile goes through
+    // all stages with the intermediates ping-ponging between two scratch tiles in tmp_, so no
+    // full-length temporary is written. rs0 of the first stage is gathered and rd, where the
+    // last stage writes, scattered through their layouts. Each Chunked slot has its own three
+    // tiles, the third for the rs1 operands the stages gather.
+    void Pass(Unit* c, const std::vector<AiInst*>& chain, uint32_t rd) {
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        auto src = reinterpret_cast<const uint8_t*>(c->acc_->comm_reg_.Get(chain.front()->rs0_));
+        auto dst = reinterpret_cast<uint8_t*>(c->acc_->comm_reg_.Get(rd));
+        auto l0 = OperandLayout(c, VS0_STRIDE, VS0_INDEX);
+        auto ld = OperandLayout(c, VD_STRIDE, VD_INDEX);
+        const uint32_t in_bytes = chain.front()->in_bytes_, out_bytes = chain.back()->out_bytes_;
+        const uint32_t tile_bytes = FuseTile * 16;
+        Chunked(c, len, c->acc_->tmp_.Size() / (3 * tile_bytes), [&](uint32_t slot, uint64_t begin, uint32_t count) {
+            uint8_t* scratch[3] = {c->acc_->tmp_.Get() + 3 * slot * tile_bytes,
+                                   c->acc_->tmp_.Get() + (3 * slot + 1) * tile_bytes,
+                                   c->acc_->tmp_.Get() + (3 * slot + 2) * tile_bytes};
+            for (uint64_t first = begin; first < begin + count; first += FuseTile) {
+                uint32_t n = std::min<uint64_t>(FuseTile, begin + count - first);
+                const void* in = src + first * in_bytes;
+                if (!l0.Packed()) {
+                    vec::Gather(src, in_bytes, l0, first, n, scratch[1]);
+                    in = scratch[1];
+                }
+                for (size_t s = 0; s != chain.size(); ++s) {
+                    bool direct = s + 1 == chain.size() && ld.Packed();
+                    void* out = direct ? dst + first * out_bytes : scratch[s % 2];
+                    chain[s]->tile_(c, out, in, first, n, scratch[2]);
+                    in = out;
+                }
+                if (!ld.Packed()) vec::Scatter(in, out_bytes, ld, first, n, dst);
+            }
+        });
+    }
+
+    // Give an elementwise instruction both its whole-vector kernel and the tile_ form used by
+    // fused chains. span(c, rdp, rp0, first, len, scratch) handles len elements starting at
+    // element first; rdp and rp0 already point at that element, other operands are fetched
+    // with Operand. Packed operands are handed over whole, others go through a Pass.
+    template <typename Out, typename In, typename Span>
+    void Tiled(AiInst* res, Span span) {
+        res->in_bytes_ = sizeof(In);
+        res->out_bytes_ = sizeof(Out);
+        res->tile_ = [span](Unit* c, void* dst, const void* src, uint64_t first, uint32_t n, void* scratch) {
+            span(c, reinterpret_cast<Out*>(dst), reinterpret_cast<const In*>(src), first, n, scratch);
+        };
+        res->kernel_ = [res, span](Unit* c) {
+            if (!OperandLayout(c, VD_STRIDE, VD_INDEX).Packed() || !OperandLayout(c, VS0_STRIDE, VS0_INDEX).Packed() ||
+                !OperandLayout(c, VS1_STRIDE, VS1_INDEX).Packed()) {
+                Pass(c, {res}, res->rd_);
+                c->pc_ += 1;
+                return;
+            }
+            auto rdp = reinterpret_cast<Out*>(c->acc_->comm_reg_.Get(res->rd_));
+            auto rp0 = reinterpret_cast<const In*>(c->acc_->comm_reg_.Get(res->rs0_));
+            Chunked(c, c->acc_->spec_reg_.Get(VLEN), UINT32_MAX, [&](uint32_t, uint64_t first, uint32_t n) {
+                span(c, rdp + first, rp0 + first, first, n, nullptr);
+            });
+            c->pc_ += 1;
+        };
+    }
+
+    // Builders of the typed vector instructions, Op being one of the tai::vec operations.
+    template <typename Out, typename In, typename Op>
+    Instruction* Unary(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs, const char* name, Op op = Op()) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        Tiled<Out, In>(res, [op](Unit*, Out* rdp, const In* rp0, uint64_t, uint32_t len, void*) {
+            vec::Map(rdp, rp0, len, op);
+        });
+        res->rd_ = rd;
+        res->rs0_ = rs;
+        res->name = name;
+        return res;
+    }
+
+    // Float exp and log10: libm or one of the polynomial kernels, as MATH_MODE says per launch.
+    template <typename Out, typename In, typename Libm, typename Poly>
+    Instruction* Math(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        Tiled<Out, In>(res, [](Unit* c, Out* rdp, const In* rp0, uint64_t, uint32_t len, void*) {
+            auto mode = static_cast<vec::MathMode>(c->acc_->spec_reg_.Get(MATH_MODE));
+            if (mode == vec::MathMode::Libm) {
+                vec::Map(rdp, rp0, len, Libm());
+            } else {
+                vec::Map(rdp, rp0, len, Poly{mode == vec::MathMode::Fast});
+            }
+        });
+        res->rd_ = rd;
+        res->rs0_ = rs;
+        res->name = name;
+        return res;
+    }
+
+    template <typename Out, typename In, typename Op>
+    Instruction* Binary(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        Tiled<Out, In>(res, [res](Unit* c, Out* rdp, const In* rp0, uint64_t first, uint32_t len, void* scratch) {
+            auto rp1 = Operand(reinterpret_cast<const In*>(c->acc_->comm_reg_.Get(res->rs1_)),
+                               OperandLayout(c, VS1_STRIDE, VS1_INDEX), first, len, scratch);
+            vec::Map(rdp, rp0, rp1, len, Op());
+        });
+        res->rd_ = rd;
+        res->rs0_ = rs0;
+        res->rs1_ = rs1;
+        res->name = name;
+        return res;
+    }
+
+    // part(first, n, scratch) of every VecChunk piece of [0, len), indexed by chunk, init if
+    // len is 0. scratch holds a chunk of the widest element in tmp_. Combined with vec::Tree
+    // the result is the same whichever slots computed the pieces.
+    template <typename P, typename Part>
+    std::vector<P> Partials(Unit* c, uint64_t len, P init, Part part) {
+        std::vector<P> res(std::max<uint64_t>(1, (len + VecChunk - 1) / VecChunk), init);
+        const uint32_t chunk_bytes = VecChunk * 16;
+        Chunked(c, len, c->acc_->tmp_.Size() / chunk_bytes, [&](uint32_t slot, uint64_t begin, uint32_t count) {
+            void* scratch = c->acc_->tmp_.Get() + slot * chunk_bytes;
+            for (uint64_t first = begin; first < begin + count; first += VecChunk) {
+                res[first / VecChunk] = part(first, std::min<uint64_t>(VecChunk, begin + count - first), scratch);
+            }
+        });
+        return res;
+    }
+
+    // rd[0] = reduction of rs over VLEN elements, from 0 for Add and from the first element
+    // otherwise.
+    template <typename T, typename Op>
+    Instruction* Reduce(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        res->kernel_ = [res](Unit* c) {
+            auto rdp = reinterpret_cast<T*>(c->acc_->comm_reg_.Get(res->rd_));
+            auto rp0 = reinterpret_cast<const T*>(c->acc_->comm_reg_.Get(res->rs0_));
+            uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+            auto l0 = OperandLayout(c, VS0_STRIDE, VS0_INDEX);
+            T init = std::is_same<Op, vec::Add>::value ? T(0) : rp0[l0.At(0)];
+            auto part = Partials(c, len, init, [&](uint64_t first, uint32_t n, void* scratch) {
+                return vec::Fold(Operand(rp0, l0, first, n, scratch), n, init, Op());
+            });
+            rdp[0] = vec::Tree(part.data(), part.size(), Op());
+            c->pc_ += 1;
+        };
+        res->rd_ = rd;
+        res->rs0_ = rs;
+        res->name = name;
+        return res;
+    }
+
+    // rd = vec::Arg<T> of rs over VLEN elements: the largest (Max) or smallest (Min) element
+    // and the index of its first occurrence, counted in elements of the VS0 layout.
+    template <typename T, typename Op>
+    Instruction* ArgReduce(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        res->kernel_ = [res](Unit* c) {
+            auto rdp = reinterpret_cast<vec::Arg<T>*>(c->acc_->comm_reg_.Get(res->rd_));
+            auto rp0 = reinterpret_cast<const T*>(c->acc_->comm_reg_.Get(res->rs0_));
+            uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+            auto l0 = OperandLayout(c, VS0_STRIDE, VS0_INDEX);
+            vec::Arg<T> init{rp0[l0.At(0)], 0};
+            auto part = Partials(c, len, init, [&](uint64_t first, uint32_t n, void* scratch) {
+                return vec::ArgFold(Operand(rp0, l0, first, n, scratch), n, first, init, Op());
+            });
+            rdp[0] = vec::Tree(part.data(), part.size(), vec::ArgOp<Op>());
+            c->pc_ += 1;
+        };
+        res->rd_ = rd;
+        res->rs0_ = rs;
+        res->name = name;
+        return res;
+    }
+
+    // fn(item) for items [0, count) that together cover len elements, item k in slot
+    // k % slots.
+    template <typename Fn>
+    void Spread(Unit* c, uint64_t len, uint64_t count, Fn fn) {
+        uint32_t slots = Slots(c, len, count);
+        if (slots <= 1) {
+            for (uint64_t k = 0; k < count; ++k) {
+                fn(k);
+            }
+            return;
+        }
+        c->acc_->pool_.ParallelFor(slots, [&](uint32_t slot) {
+            for (uint64_t k = slot; k < count; k += slots) {
+                fn(k);
+            }
+        });
+    }
+
+    // Columns of the running result kept hot while the rows of a strided axis stream past.
+    constexpr uint32_t AxisTile = 2048;
+
+    // Reduce the NDIM-dimensional row-major X_SIZE x Y_SIZE x Z_SIZE tensor in rs along axis
+    // REDUCE_AXIS (0 for x, outermost). rd gets the tensor with that axis removed. The last
+    // axis is contiguous, each output is a pairwise Fold of its row; along the other axes the
+    // output rows are accumulated elementwise, AxisTile columns at a time. Outputs are spread
+    // over the pool.
+    template <typename T, typename Op>
+    Instruction* AxisReduce(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        res->kernel_ = [res](Unit* c) {
+            auto rdp = reinterpret_cast<T*>(c->acc_->comm_reg_.Get(res->rd_));
+            auto rp0 = reinterpret_cast<const T*>(c->acc_->comm_reg_.Get(res->rs0_));
+            uint32_t ndim = c->acc_->spec_reg_.Get(NDIM);
+            uint32_t axis = c->acc_->spec_reg_.Get(REDUCE_AXIS);
+            uint64_t size[3] = {c->acc_->spec_reg_.Get(X_SIZE), c->acc_->spec_reg_.Get(Y_SIZE),
+                                c->acc_->spec_reg_.Get(Z_SIZE)};
+            if (ndim < 1 || ndim > 3 || axis >= ndim) {
+                c->pc_ += 1;
+                return;
+            }
+            uint64_t outer = 1, n = size[axis], inner = 1;
+            for (uint32_t d = 0; d < axis; ++d) outer *= size[d];
+            for (uint32_t d = axis + 1; d < ndim; ++d) inner *= size[d];
+
+            if (inner == 1) {
+                Spread(c, outer * n, outer, [&](uint64_t o) {
+                    const T* row = rp0 + o * n;
+                    T init = std::is_same<Op, vec::Add>::value || n == 0 ? T(0) : row[0];
+                    rdp[o] = vec::Fold(row, n, init, Op());
+                });
+            } else {
+                uint64_t tiles = (inner + AxisTile - 1) / AxisTile;
+                Spread(c, outer * n * inner, outer * tiles, [&](uint64_t k) {
+                    uint64_t o = k / tiles, first = k % tiles * AxisTile;
+                    uint32_t m = std::min<uint64_t>(AxisTile, inner - first);
+                    const T* src = rp0 + o * n * inner + first;
+                    T* dst = rdp + o * inner + first;
+                    if (n == 0) {
+                        std::fill(dst, dst + m, T(0));
+                        return;
+                    }
+                    std::copy(src, src + m, dst);
+                    for (uint64_t j = 1; j < n; ++j) {
+                        vec::Map(dst, dst, src + j * inner, m, Op());
+                    }
+                });
+            }
+            c->pc_ += 1;
+        };
+        res->rd_ = rd;
+        res->rs0_ = rs;
+        res->name = name;
+        return res;
+    }
+
+    // rd[s] = reduction of rs over [off[s], off[s + 1]) for the SEGMENTS segments, off being
+    // the SEGMENTS + 1 uint32 offsets at rs1. Empty segments give 0. Each segment is a
+    // pairwise Fold; segments are spread over the pool.
+    template <typename T, typename Op>
+    Instruction* SegReduce(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        res->kernel_ = [res](Unit* c) {
+            auto rdp = reinterpret_cast<T*>(c->acc_->comm_reg_.Get(res->rd_));
+            auto rp0 = reinterpret_cast<const T*>(c->acc_->comm_reg_.Get(res->rs0_));
+            auto off = reinterpret_cast<const uint32_t*>(c->acc_->comm_reg_.Get(res->rs1_));
+            uint32_t count = c->acc_->spec_reg_.Get(SEGMENTS);
+            uint64_t len = count ? off[count] - off[0] : 0;
+            Spread(c, len, count, [&](uint64_t s) {
+                uint32_t n = off[s + 1] > off[s] ? off[s + 1] - off[s] : 0;
+                const T* seg = rp0 + off[s];
+                T init = std::is_same<Op, vec::Add>::value || n == 0 ? T(0) : seg[0];
+                rdp[s] = vec::Fold(seg, n, init, Op());
+            });
+            c->pc_ += 1;
+        };
+        res->rd_ = rd;
+        res->rs0_ = rs0;
+        res->rs1_ = rs1;
+        res->name = name;
+        return res;
+    }
+
+    // Fuse chain, in execution order, into one Pass on its first instruction, which skips the
+    // rest; rd is where the last stage writes.
+    void Fuse(const std::vector<AiInst*>& chain, uint32_t rd) {
+        chain.front()->kernel_ = [chain, rd](Unit* c) {
+            Pass(c, chain, rd);
+            c->pc_ += chain.size();
+        };
+    }
+
+    // GEMM.* with X_SIZE x Y_SIZE a and Y_SIZE x Z_SIZE b, through the blocked kernel.
+    template <typename T>
+    Instruction* Matmul(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1, const char* name) {
+        auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
+        res->kernel_ = [res](Unit* c) {
+            auto rdp = reinterpret_cast<T*>(c->acc_->comm_reg_.Get(res->rd_));
+            auto rp0 = reinterpret_cast<const T*>(c->acc_->comm_reg_.Get(res->rs0_));
+            auto rp1 = reinterpret_cast<const T*>(c->acc_->comm_reg_.Get(res->rs1_));
+            uint32_t m = c->acc_->spec_reg_.Get(X_SIZE);
+            uint32_t p = c->acc_->spec_reg_.Get(Y_SIZE);
+            uint32_t n = c->acc_->spec_reg_.Get(Z_SIZE);
+            uint32_t threads = Slots(c, uint64_t(m) * p * n, UINT32_MAX);
+            tai::Gemm(c->acc_->pool_, threads, rp0, rp1, rdp, m, p, n);
+            c->pc_ += 1;
+        };
+        res->rd_ = rd;
+        res->rs0_ = rs0;
+        res->rs1_ = rs1;
+        res->name = name;
+        return res;
+    }
+}
+
 Program::Program() {
     built = false;
     path_num_ = 0;
@@ -47,14 +412,20 @@ void Program::Build() {
                     }
                     combine.insert(combine.begin(), reinterpret_cast<AiInst*>(insts_[i]));
                     i += 1;
-                    int forward_reg = FWD_TMP;
-                    // assert combine.size() >= 2
-                    for (auto iter = combine.begin() + 1; iter != combine.end(); ++iter) {
-                        (*iter)->rs0_ = forward_reg;
-                        (*iter)->rd_ = forward_reg;
+                    bool tiled = std::all_of(combine.begin(), combine.end(),
+                                             [](AiInst* a) { return bool(a->tile_); });
+                    if (tiled) {
+                        Fuse(combine, combine.front()->rd_);
+                    } else {
+                        int forward_reg = FWD_TMP;
+                        // assert combine.size() >= 2
+                        for (auto iter = combine.begin() + 1; iter != combine.end(); ++iter) {
+                            (*iter)->rs0_ = forward_reg;
+                            (*iter)->rd_ = forward_reg;
+                        }
+                        combine.back()->rd_ = combine.front()->rd_;
+                        combine.front()->rd_ = forward_reg;
                     }
-                    combine.back()->rd_ = combine.front()->rd_;
-                    combine.front()->rd_ = forward_reg;
                     for (size_t j = 0; j != combine.size(); ++j) {
                         insts_.at(i - combine.size() + j) = combine.at(j);
                     }
@@ -485,860 +856,250 @@ Instruction* Program::Slli(uint32_t rd, uint32_t rs0, int imm) {
 
 // 1/12
 Instruction* Program::VaddI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] + rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VADDI32";
-    return res;
+    return Binary<int32_t, int32_t, vec::Add>(path, dri, dro, rd, rs0, rs1, "VADDI32");
 }
 Instruction* Program::VsubI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VSUBI32";
-    return res;
+    return Binary<int32_t, int32_t, vec::Sub>(path, dri, dro, rd, rs0, rs1, "VSUBI32");
 }
 Instruction* Program::VmulI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VMULI32";
-    return res;
+    return Binary<int32_t, int32_t, vec::Mul>(path, dri, dro, rd, rs0, rs1, "VMULI32");
 }
 // 2/12
 Instruction* Program::VaddF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] + rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VADDF32";
-    return res;
+    return Binary<float, float, vec::Add>(path, dri, dro, rd, rs0, rs1, "VADDF32");
 }
 Instruction* Program::VsubF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VSUBF32";
-    return res;
+    return Binary<float, float, vec::Sub>(path, dri, dro, rd, rs0, rs1, "VSUBF32");
 }
 Instruction* Program::VmulF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VMULF32";
-    return res;
+    return Binary<float, float, vec::Mul>(path, dri, dro, rd, rs0, rs1, "VMULF32");
 }
 //working 3/12
 Instruction* Program::VaddF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] + rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VADDF64";
-    return res;
+    return Binary<double, double, vec::Add>(path, dri, dro, rd, rs0, rs1, "VADDF64");
 }
 Instruction* Program::VsubF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VSUBF64";
-    return res;
+    return Binary<double, double, vec::Sub>(path, dri, dro, rd, rs0, rs1, "VSUBF64");
 }
 Instruction* Program::VmulF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VMULF64";
-    return res;
+    return Binary<double, double, vec::Mul>(path, dri, dro, rd, rs0, rs1, "VMULF64");
 }
 //working 4/12
 Instruction* Program::VaddiI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, int32_t imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] + imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    // res->rs1_= imm;
-    res->name = "VADDII32";
-    return res;
+    return Unary<int32_t, int32_t>(path, dri, dro, rd, rs0, "VADDII32", vec::WithImm<vec::Add, int32_t>{imm});
 }
 Instruction* Program::VsubiI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, int32_t imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    // res->rs1_= imm;
-    res->name = "VSUBII32";
-    return res;
+    return Unary<int32_t, int32_t>(path, dri, dro, rd, rs0, "VSUBII32", vec::WithImm<vec::Sub, int32_t>{imm});
 }
 Instruction* Program::VmuliI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, int32_t imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    // res->rs1_= imm;
-    res->name = "VMULII32";
-    return res;
+    return Unary<int32_t, int32_t>(path, dri, dro, rd, rs0, "VMULII32", vec::WithImm<vec::Mul, int32_t>{imm});
 }
 //working 5/12
 Instruction* Program::VaddiF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] + imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VADDIF32";
-    return res;
+    return Unary<float, float>(path, dri, dro, rd, rs0, "VADDIF32", vec::WithImm<vec::Add, float>{imm});
 }
 Instruction* Program::VsubiF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VSUBIF32";
-    return res;
+    return Unary<float, float>(path, dri, dro, rd, rs0, "VSUBIF32", vec::WithImm<vec::Sub, float>{imm});
 }
 Instruction* Program::VmuliF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VMULIF32";
-    return res;
+    return Unary<float, float>(path, dri, dro, rd, rs0, "VMULIF32", vec::WithImm<vec::Mul, float>{imm});
 }
 //working 6/12
-Instruction* Program::VaddiF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm) { 
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] + imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VADDIF64";
-    return res;
+Instruction* Program::VaddiF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm) {
+    return Unary<double, double>(path, dri, dro, rd, rs0, "VADDIF64", vec::WithImm<vec::Add, double>{imm});
 }
-Instruction* Program::VsubiF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm) { 
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VSUBIF64";
-    return res;
+Instruction* Program::VsubiF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm) {
+    return Unary<double, double>(path, dri, dro, rd, rs0, "VSUBIF64", vec::WithImm<vec::Sub, double>{imm});
 }
 Instruction* Program::VmuliF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VMULIF64";
-    return res;
+    return Unary<double, double>(path, dri, dro, rd, rs0, "VMULIF64", vec::WithImm<vec::Mul, double>{imm});
 }
 
 //working 7/12
-Instruction* Program::VabsI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = abs(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    //res->rs1_ = rs1;
-    res->name = "VABSI32";
-    return res;
+Instruction* Program::VabsI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<int32_t, int32_t, vec::Abs>(path, dri, dro, rd, rs, "VABSI32");
 }
-Instruction* Program::VabsF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = fabsf(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    //res->rs1_ = rs1;
-    res->name = "VABSF32";
-    return res;
+Instruction* Program::VabsF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<float, float, vec::Abs>(path, dri, dro, rd, rs, "VABSF32");
 }
-Instruction* Program::VabsF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = fabs(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    //res->rs1_ = rs1;
-    res->name = "VABSF64";
-    return res;
+Instruction* Program::VabsF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, double, vec::Abs>(path, dri, dro, rd, rs, "VABSF64");
 }
-Instruction* Program::VabsC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = cabsf(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    //res->rs1_ = rs1;
-    res->name = "VABSC32";
-    return res;
+Instruction* Program::VabsC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<float, vec::C32, vec::Abs>(path, dri, dro, rd, rs, "VABSC32");
 }
-Instruction* Program::VabsC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double*>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = cabs(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    //res->rs1_ = rs1;
-    res->name = "VABSC64";
-    return res;
+Instruction* Program::VabsC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, vec::C64, vec::Abs>(path, dri, dro, rd, rs, "VABSC64");
 }
 
 // 8/12
-Instruction* Program::VsquaI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = pow(rp0[i],2);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VSQUAI32";
-    return res;
+Instruction* Program::VsquaI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<int32_t, int32_t, vec::Squa>(path, dri, dro, rd, rs, "VSQUAI32");
 }
-Instruction* Program::VsquaF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = powf(rp0[i],2);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VSQUAF32";
-    return res;
+Instruction* Program::VsquaF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<float, float, vec::Squa>(path, dri, dro, rd, rs, "VSQUAF32");
 }
-Instruction* Program::VsquaF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = pow(rp0[i],2);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VSQUAF64";
-    return res;
+Instruction* Program::VsquaF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, double, vec::Squa>(path, dri, dro, rd, rs, "VSQUAF64");
 }
 
 // 9/12
-Instruction* Program::VnegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = -rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VNEGI32";
-    return res;
+Instruction* Program::VnegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<int32_t, int32_t, vec::Neg>(path, dri, dro, rd, rs, "VNEGI32");
 }
-Instruction* Program::VnegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = -rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VNEGF32";
-    return res;
+Instruction* Program::VnegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<float, float, vec::Neg>(path, dri, dro, rd, rs, "VNEGF32");
 }
-Instruction* Program::VnegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = -rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VNEGF64";
-    return res;
+Instruction* Program::VnegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, double, vec::Neg>(path, dri, dro, rd, rs, "VNEGF64");
 }
-Instruction* Program::VrecI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = 1.0 / rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VRECI32";
-    return res;
+Instruction* Program::VrecI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, int32_t, vec::Rec>(path, dri, dro, rd, rs, "VRECI32");
 }
-Instruction* Program::VrecF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = 1 / rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VRECF32";
-    return res;
+Instruction* Program::VrecF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<float, float, vec::Rec>(path, dri, dro, rd, rs, "VRECF32");
 }
-Instruction* Program::VrecF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = 1 / rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VRECF64";
-    return res;
+Instruction* Program::VrecF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, double, vec::Rec>(path, dri, dro, rd, rs, "VRECF64");
 }
 // 10/12
-Instruction* Program::VexpI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = exp(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VEXPI32";
-    return res;
+Instruction* Program::VexpI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<int32_t, int32_t, vec::Exp>(path, dri, dro, rd, rs, "VEXPI32");
 }
-Instruction* Program::VexpF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = expf(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VEXPF32";
-    return res;
+Instruction* Program::VexpF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Math<float, float, vec::Exp, vec::ExpPoly>(path, dri, dro, rd, rs, "VEXPF32");
 }
-Instruction* Program::VexpF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = exp(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VEXPF64";
-    return res;
+Instruction* Program::VexpF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Math<double, double, vec::Exp, vec::ExpPoly>(path, dri, dro, rd, rs, "VEXPF64");
 }
 
 // 11/12
-Instruction* Program::Vlog10I32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = log10(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VLOG10I32";
-    return res;
+Instruction* Program::Vlog10I32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Unary<double, int32_t, vec::Log10>(path, dri, dro, rd, rs, "VLOG10I32");
 }
-Instruction* Program::Vlog10F32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = log10(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VLOG10F32";
-    return res;
+Instruction* Program::Vlog10F32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Math<double, float, vec::Log10, vec::Log10Poly>(path, dri, dro, rd, rs, "VLOG10F32");
 }
-Instruction* Program::Vlog10F64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = log10(rp0[i]);
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VLOG10F64";
-    return res;
+Instruction* Program::Vlog10F64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Math<double, double, vec::Log10, vec::Log10Poly>(path, dri, dro, rd, rs, "VLOG10F64");
 }
 
 // 12/12
 Instruction* Program::VconjC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[2*i] = rp0[2*i];
-            rdp[2*i+1] = -rp0[2*i+1];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VCONJC32";
-    return res;
+    return Unary<vec::C32, vec::C32, vec::Conj>(path, dri, dro, rd, rs, "VCONJC32");
 }
 
 Instruction* Program::VconjC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[2*i] = rp0[2*i];
-            rdp[2*i+1] = -rp0[2*i+1];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "VCONJC64";
-    return res;
+    return Unary<vec::C64, vec::C64, vec::Conj>(path, dri, dro, rd, rs, "VCONJC64");
 }
 
 // 1/3
-Instruction* Program::VsumI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        rdp[0] = 0;
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[0] += rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "SUMI32";
-    return res;
+Instruction* Program::VsumI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<int32_t, vec::Add>(path, dri, dro, rd, rs, "SUMI32");
 }
-Instruction* Program::VsumF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        rdp[0] = 0;
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[0] += rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "SUMF32";
-    return res;
+Instruction* Program::VsumF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<float, vec::Add>(path, dri, dro, rd, rs, "SUMF32");
 }
-Instruction* Program::VsumF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        rdp[0] = 0;
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[0] += rp0[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "SUMF64";
-    return res;
+Instruction* Program::VsumF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<double, vec::Add>(path, dri, dro, rd, rs, "SUMF64");
 }
 
 // 2/3
-Instruction* Program::VmaxI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        int32_t max = rp0[0];
-        for (uint32_t i = 0; i < len; ++i) {
-            if (rp0[i]>max) max = rp0[i];
-        }
-        rdp[0] = max;
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "MAXI32";
-    return res;
+Instruction* Program::VmaxI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<int32_t, vec::Max>(path, dri, dro, rd, rs, "MAXI32");
 }
-Instruction* Program::VmaxF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        float max = rp0[0];
-        for (uint32_t i = 0; i < len; ++i) {
-            if (rp0[i]>max) max = rp0[i];
-        }
-        rdp[0] = max;
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "MAXF32";
-    return res;
+Instruction* Program::VmaxF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<float, vec::Max>(path, dri, dro, rd, rs, "MAXF32");
 }
-Instruction* Program::VmaxF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        double max = rp0[0];
-        for (uint32_t i = 0; i < len; ++i) {
-            if (rp0[i]>max) max = rp0[i];
-        }
-        rdp[0] = max;
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "MAXF64";
-    return res;
+Instruction* Program::VmaxF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<double, vec::Max>(path, dri, dro, rd, rs, "MAXF64");
 }
 
 // 3/3
-Instruction* Program::VminI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        int32_t min = rp0[0];
-        for (uint32_t i = 0; i < len; ++i) {
-            if (rp0[i]<min) min = rp0[i];
-        }
-        rdp[0] = min;
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "MINI32";
-    return res;
+Instruction* Program::VminI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<int32_t, vec::Min>(path, dri, dro, rd, rs, "MINI32");
 }
-Instruction* Program::VminF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        float min = rp0[0];
-        for (uint32_t i = 0; i < len; ++i) {
-            if (rp0[i]<min) min = rp0[i];
-        }
-        rdp[0] = min;
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "MINF32";
-    return res;
+Instruction* Program::VminF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<float, vec::Min>(path, dri, dro, rd, rs, "MINF32");
 }
-Instruction* Program::VminF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs){
-    auto res = new AiInst{path, dri, dro, [](Unit*){}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c){
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        double min = rp0[0];
-        for (uint32_t i = 0; i < len; ++i) {
-            if (rp0[i]<min) min = rp0[i];
-        }
-        rdp[0] = min;
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs;
-    res->name = "MINF64";
-    return res;
+Instruction* Program::VminF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return Reduce<double, vec::Min>(path, dri, dro, rd, rs, "MINF64");
+}
+
+// along an axis, over segments
+Instruction* Program::VsumAxisI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<int32_t, vec::Add>(path, dri, dro, rd, rs, "SUMAXISI32");
+}
+Instruction* Program::VsumAxisF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<float, vec::Add>(path, dri, dro, rd, rs, "SUMAXISF32");
+}
+Instruction* Program::VsumAxisF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<double, vec::Add>(path, dri, dro, rd, rs, "SUMAXISF64");
+}
+Instruction* Program::VmaxAxisI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<int32_t, vec::Max>(path, dri, dro, rd, rs, "MAXAXISI32");
+}
+Instruction* Program::VmaxAxisF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<float, vec::Max>(path, dri, dro, rd, rs, "MAXAXISF32");
+}
+Instruction* Program::VmaxAxisF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<double, vec::Max>(path, dri, dro, rd, rs, "MAXAXISF64");
+}
+Instruction* Program::VminAxisI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<int32_t, vec::Min>(path, dri, dro, rd, rs, "MINAXISI32");
+}
+Instruction* Program::VminAxisF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<float, vec::Min>(path, dri, dro, rd, rs, "MINAXISF32");
+}
+Instruction* Program::VminAxisF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return AxisReduce<double, vec::Min>(path, dri, dro, rd, rs, "MINAXISF64");
+}
+Instruction* Program::VsumSegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<int32_t, vec::Add>(path, dri, dro, rd, rs0, rs1, "SUMSEGI32");
+}
+Instruction* Program::VsumSegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<float, vec::Add>(path, dri, dro, rd, rs0, rs1, "SUMSEGF32");
+}
+Instruction* Program::VsumSegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<double, vec::Add>(path, dri, dro, rd, rs0, rs1, "SUMSEGF64");
+}
+Instruction* Program::VmaxSegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<int32_t, vec::Max>(path, dri, dro, rd, rs0, rs1, "MAXSEGI32");
+}
+Instruction* Program::VmaxSegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<float, vec::Max>(path, dri, dro, rd, rs0, rs1, "MAXSEGF32");
+}
+Instruction* Program::VmaxSegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<double, vec::Max>(path, dri, dro, rd, rs0, rs1, "MAXSEGF64");
+}
+Instruction* Program::VminSegI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<int32_t, vec::Min>(path, dri, dro, rd, rs0, rs1, "MINSEGI32");
+}
+Instruction* Program::VminSegF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<float, vec::Min>(path, dri, dro, rd, rs0, rs1, "MINSEGF32");
+}
+Instruction* Program::VminSegF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return SegReduce<double, vec::Min>(path, dri, dro, rd, rs0, rs1, "MINSEGF64");
+}
+
+// argmax, argmin
+Instruction* Program::VargmaxI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return ArgReduce<int32_t, vec::Max>(path, dri, dro, rd, rs, "ARGMAXI32");
+}
+Instruction* Program::VargmaxF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return ArgReduce<float, vec::Max>(path, dri, dro, rd, rs, "ARGMAXF32");
+}
+Instruction* Program::VargmaxF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return ArgReduce<double, vec::Max>(path, dri, dro, rd, rs, "ARGMAXF64");
+}
+Instruction* Program::VargminI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return ArgReduce<int32_t, vec::Min>(path, dri, dro, rd, rs, "ARGMINI32");
+}
+Instruction* Program::VargminF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return ArgReduce<float, vec::Min>(path, dri, dro, rd, rs, "ARGMINF32");
+}
+Instruction* Program::VargminF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    return ArgReduce<double, vec::Min>(path, dri, dro, rd, rs, "ARGMINF64");
 }
 
 // 1/2 transpose (ndim, xsize, ysize, zsize)
@@ -1553,91 +1314,13 @@ Instruction* Program::PermuteF64(int path, Drive dri, Drive dro, uint32_t rd, ui
 }
 
 Instruction* Program::GemmI32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<int32_t *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t m = c->acc_->spec_reg_.Get(X_SIZE);
-        uint32_t p = c->acc_->spec_reg_.Get(Y_SIZE);
-        uint32_t n = c->acc_->spec_reg_.Get(Z_SIZE);
-        for (int i = 0; i < m; ++i) {
-            for (int j = 0; j < n; ++j) {
-                rdp[i*n+j] = 0;
-            }
-        }
-        for (int i = 0; i < m; ++i) {
-            for (int l = 0; l < p; ++l) {
-                for (int j = 0; j < n; ++j) {
-                    rdp[i*n+j] += rp0[i*p+l]*rp1[l*n+j];
-                }
-            }
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "GEMM.I32";
-    return res;
+    return Matmul<int32_t>(path, dri, dro, rd, rs0, rs1, "GEMM.I32");
 }
 Instruction* Program::GemmF32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t m = c->acc_->spec_reg_.Get(X_SIZE);
-        uint32_t p = c->acc_->spec_reg_.Get(Y_SIZE);
-        uint32_t n = c->acc_->spec_reg_.Get(Z_SIZE);
-        for (int i = 0; i < m; ++i) {
-            for (int j = 0; j < n; ++j) {
-                rdp[i*n+j] = 0;
-            }
-        }
-        for (int i = 0; i < m; ++i) {
-            for (int l = 0; l < p; ++l) {
-                for (int j = 0; j < n; ++j) {
-                    rdp[i*n+j] += rp0[i*p+l]*rp1[l*n+j];
-                }
-            }
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "GEMM.F32";
-    return res;
+    return Matmul<float>(path, dri, dro, rd, rs0, rs1, "GEMM.F32");
 }
 Instruction* Program::GemmF64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<double *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t m = c->acc_->spec_reg_.Get(X_SIZE);
-        uint32_t p = c->acc_->spec_reg_.Get(Y_SIZE);
-        uint32_t n = c->acc_->spec_reg_.Get(Z_SIZE);
-        for (int i = 0; i < m; ++i) {
-            for (int j = 0; j < n; ++j) {
-                rdp[i*n+j] = 0;
-            }
-        }
-        for (int i = 0; i < m; ++i) {
-            for (int l = 0; l < p; ++l) {
-                for (int j = 0; j < n; ++j) {
-                    rdp[i*n+j] += rp0[i*p+l]*rp1[l*n+j];
-                }
-            }
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "GEMM.F64";
-    return res;
+    return Matmul<double>(path, dri, dro, rd, rs0, rs1, "GEMM.F64");
 }
 Instruction* Program::GemmC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
     auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
@@ -1699,96 +1382,28 @@ Instruction* Program::GemmC64(int path, Drive dri, Drive dro, uint32_t rd, uint3
 }
 
 Instruction* Program::VmulC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float _Complex *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float _Complex *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<float _Complex *>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        /*if (len < 1000 || len > 64000) {
-            std::cerr << "SIZE ERROS: for vmulc32(u, v), length of u,v should be [1k, 64K]" << std::endl;
-            return;
-        }*/
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VMULC32";
-    return res;
+    return Binary<vec::C32, vec::C32, vec::Mul>(path, dri, dro, rd, rs0, rs1, "VMULC32");
 }
-Instruction* Program::VsubC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VSUBC32";
-    return res;
+Instruction* Program::VmulC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return Binary<vec::C64, vec::C64, vec::Mul>(path, dri, dro, rd, rs0, rs1, "VMULC64");
 }
-Instruction* Program::VsubC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<double _Complex*>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp1 = reinterpret_cast<double _Complex*>(c->acc_->comm_reg_.Get(res->rs1_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] - rp1[i];
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    res->rs1_ = rs1;
-    res->name = "VSUBC64";
-    return res;
+Instruction* Program::VaddC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return Binary<vec::C32, vec::C32, vec::Add>(path, dri, dro, rd, rs0, rs1, "VADDC32");
 }
-Instruction* Program::VmuliC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float _Complex imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VMULIC32";
-    return res;
+Instruction* Program::VaddC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return Binary<vec::C64, vec::C64, vec::Add>(path, dri, dro, rd, rs0, rs1, "VADDC64");
 }
-Instruction* Program::VmuliC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double _Complex imm) {
-    auto res = new AiInst{path, dri, dro, [](Unit*) {}, Tag::VecCompute};
-    res->kernel_ = [res, imm](Unit *c) {
-        auto rdp = reinterpret_cast<double _Complex *>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<double _Complex *>(c->acc_->comm_reg_.Get(res->rs0_));
-        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = rp0[i] * imm;
-        }
-        c->pc_ += 1;
-    };
-    res->rd_ = rd;
-    res->rs0_ = rs0;
-    //res->rs1_ = rs1;
-    res->name = "VMULIC64";
-    return res;
+Instruction* Program::VsubC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return Binary<vec::C32, vec::C32, vec::Sub>(path, dri, dro, rd, rs0, rs1, "VSUBC32");
+}
+Instruction* Program::VsubC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    return Binary<vec::C64, vec::C64, vec::Sub>(path, dri, dro, rd, rs0, rs1, "VSUBC64");
+}
+Instruction* Program::VmuliC32(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, float _Complex imm) {
+    return Unary<vec::C32, vec::C32>(path, dri, dro, rd, rs0, "VMULIC32", vec::WithImm<vec::Mul, vec::C32>{vec::C32(crealf(imm), cimagf(imm))});
+}
+Instruction* Program::VmuliC64(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, double _Complex imm) {
+    return Unary<vec::C64, vec::C64>(path, dri, dro, rd, rs0, "VMULIC64", vec::WithImm<vec::Mul, vec::C64>{vec::C64(creal(imm), cimag(imm))});
 }
 
 Instruction* Program::cAddi(uint32_t rd, uint32_t rs0, int32_t imm) {
@@ -2176,6 +1791,12 @@ Instruction* Program::Conv(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
             return;
         }*/
 
+        if (UseFastConv(ulen, vlen, c->acc_->spec_reg_.Get(CONV_FFT_TAPS))) {
+            FastConv<float, float>(c->acc_->fft_plans_, c->acc_->pool_, rp0, ulen, rp1, vlen, rdp);
+            c->pc_ += 1;
+            return;
+        }
+
         for (uint32_t i = 0; i < len; ++i) 
             rdp[i] = 0;
         for (uint32_t i = 0; i < ulen; ++i) {
@@ -2196,12 +1817,30 @@ Instruction* Program::Conv(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
 
 
 
+namespace {
+    // Single plan below FFT_LARGE, the four-step path from it on; either way the time
+    // goes to the FFT profile.
+    void FftTimed(Unit* c, const std::complex<float>* in, std::complex<float>* out, uint32_t len, FftDir dir) {
+        uint32_t large = c->acc_->spec_reg_.Get(FFT_LARGE);
+        if (large == 0) large = c->acc_->pool_.Size() > 1 ? FourStepMin : FourStepSerialMin;
+
+        auto start = std::chrono::steady_clock::now();
+        if (len >= large) {
+            FourStepFft(c->acc_->fft_plans_, c->acc_->pool_, in, out, len, dir);
+        } else {
+            c->acc_->fft_plans_.Get<float>(len, dir)->Execute(in, out);
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        c->acc_->fft_profile_.Record(len, ns.count());
+    }
+}
+
 Instruction* Program::Fft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
     auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
     res->kernel_ = [res](Unit *c) {
-        auto rdp = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
         //auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
-        auto rp0 = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
 
         uint32_t len = c->acc_->spec_reg_.Get(VLEN);
         /*
@@ -2210,12 +1849,7 @@ Instruction* Program::Fft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
             return;
         }*/
 
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = 0;
-            for (uint32_t j = 0; j < len; ++j) {
-                rdp[i] += rp0[j] * cexpf(-2*PI*I*i*j/len);
-            }
-        }
+        FftTimed(c, rp0, rdp, len, FftDir::Forward);
         c->pc_ += 1;
     };
     res->rd_ = rd;
@@ -2224,11 +1858,74 @@ Instruction* Program::Fft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
     return res;
 }
 
+Instruction* Program::FftPrune(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t first = c->acc_->spec_reg_.Get(BIN_FIRST);
+        uint32_t stride = c->acc_->spec_reg_.Get(BIN_STRIDE);
+        uint32_t count = c->acc_->spec_reg_.Get(BIN_COUNT);
+
+        PrunedFft(c->acc_->fft_plans_, c->acc_->pool_, rp0, len, first, stride, count, rdp);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "FFT.PRUNE";
+    return res;
+}
+
+Instruction* Program::Czt(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        uint64_t start = c->acc_->spec_reg_.Get(CZT_START);
+        uint64_t step = c->acc_->spec_reg_.Get(CZT_STEP);
+        uint32_t points = c->acc_->spec_reg_.Get(CZT_POINTS);
+
+        ChirpZ(c->acc_->fft_plans_, c->acc_->pool_, rp0, len, start, step, points, rdp);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "CZT";
+    return res;
+}
+
+Instruction* Program::FftWin(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        auto type = static_cast<Window>(c->acc_->spec_reg_.Get(WINDOW));
+        auto window = c->acc_->windows_.Get(type, len);
+        if (!window && type != Window::Rect) {
+            std::cerr << "SIZE ERROR: unknown window type " << static_cast<uint32_t>(type) << std::endl;
+        }
+
+        auto plan = c->acc_->fft_plans_.Get<float>(len, FftDir::Forward);
+        plan->Execute(rp0, rdp, window ? window->data() : nullptr);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "FFT.WIN";
+    return res;
+}
+
 Instruction* Program::Ifft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
     auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
     res->kernel_ = [res](Unit* c) {
-        auto rdp = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rd_));
-        auto rp0 = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
 
         uint32_t len = c->acc_->spec_reg_.Get(VLEN);
         /*
@@ -2237,40 +1934,233 @@ Instruction* Program::Ifft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
             return;
         }*/
 
-        for (uint32_t i = 0; i < len; ++i) {
-            rdp[i] = 0;
-            for (uint32_t j = 0; j < len; ++j) {
-                //rdp[i] += rp0[j] * (1 / len) * cexpf(2 * PI * I * i * j / len);
-                rdp[i] += (rp0[j] * cexpf(2 * PI * I * i * j / len));
+        // the inverse plans carry the 1/len scaling
+        FftTimed(c, rp0, rdp, len, FftDir::Inverse);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "IFFT";
+    return res;
+}
+
+
+namespace {
+    void FftFixed(Unit* c, AiInst* res, FftDir dir) {
+        auto rdp = reinterpret_cast<int16_t*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<int16_t*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rp1 = reinterpret_cast<int32_t*>(c->acc_->comm_reg_.Get(res->rs1_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        if (!FftI16Plan::Supported(len)) {
+            std::cerr << "SIZE ERROR: for " << res->name << "(x), length of x should be a power of 2" << std::endl;
+            return;
+        }
+        auto plan = c->acc_->fft_plans_.GetFixed(len, dir);
+        int64_t exponent = plan->Execute(rp0, rdp, rp1);
+        c->acc_->spec_reg_.Set(BFP_EXP, static_cast<uint64_t>(exponent));
+    }
+}
+
+Instruction* Program::FftI16(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        FftFixed(c, res, FftDir::Forward);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs0;
+    res->rs1_ = rs1;
+    res->name = "FFT.I16";
+    return res;
+}
+
+Instruction* Program::IfftI16(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        FftFixed(c, res, FftDir::Inverse);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs0;
+    res->rs1_ = rs1;
+    res->name = "IFFT.I16";
+    return res;
+}
+
+Instruction* Program::Fft2d(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t x_size = c->acc_->spec_reg_.Get(X_SIZE);
+        uint32_t y_size = c->acc_->spec_reg_.Get(Y_SIZE);
+        tai::Fft2d(c->acc_->fft_plans_, c->acc_->pool_, rp0, rdp, x_size, y_size, FftDir::Forward);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "FFT2D";
+    return res;
+}
+
+Instruction* Program::Ifft2d(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t x_size = c->acc_->spec_reg_.Get(X_SIZE);
+        uint32_t y_size = c->acc_->spec_reg_.Get(Y_SIZE);
+        tai::Fft2d(c->acc_->fft_plans_, c->acc_->pool_, rp0, rdp, x_size, y_size, FftDir::Inverse);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "IFFT2D";
+    return res;
+}
+
+Instruction* Program::Rfft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        auto plan = c->acc_->fft_plans_.GetReal<float>(len);
+        plan->Forward(rp0, rdp);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "RFFT";
+    return res;
+}
+
+Instruction* Program::Irfft(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<float *>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        auto plan = c->acc_->fft_plans_.GetReal<float>(len);
+        plan->Inverse(rp0, rdp);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "IRFFT";
+    return res;
+}
+
+namespace {
+    // Rows are grouped so each pool task covers several short transforms.
+    void FftRows(Unit* c, AiInst* res, FftDir dir) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t batch = c->acc_->spec_reg_.Get(BATCH);
+        uint64_t stride = c->acc_->spec_reg_.Get(ROW_STRIDE);
+        if (stride == 0) stride = len;
+
+        auto plan = c->acc_->fft_plans_.Get<float>(len, dir);
+        uint32_t rows = std::max(1u, batch / (c->acc_->pool_.Size() * 4));
+        uint32_t tasks = (batch + rows - 1) / rows;
+        c->acc_->pool_.ParallelFor(tasks, [&](uint32_t t) {
+            uint32_t end = std::min(batch, (t + 1) * rows);
+            for (uint32_t r = t * rows; r < end; ++r) {
+                plan->Execute(rp0 + r * stride, rdp + r * stride);
             }
-            rdp[i] /= len;
+        });
+    }
+}
+
+Instruction* Program::FftBatch(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        FftRows(c, res, FftDir::Forward);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "FFT.BATCH";
+    return res;
+}
+
+Instruction* Program::IfftBatch(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        FftRows(c, res, FftDir::Inverse);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "IFFT.BATCH";
+    return res;
+}
+
+Instruction* Program::MfPrep(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t tlen = c->acc_->spec_reg_.Get(ULEN);
+        uint32_t batch = c->acc_->spec_reg_.Get(BATCH);
+        uint64_t stride = c->acc_->spec_reg_.Get(ROW_STRIDE);
+        if (tlen > len) {
+            std::cerr << "SIZE ERROR: template length " << tlen << " exceeds transform length " << len << std::endl;
         }
+        if (stride == 0) stride = tlen;
+
+        MatchedFilterPrep(c->acc_->fft_plans_, c->acc_->pool_, rp0, tlen, stride, batch, len, rdp);
         c->pc_ += 1;
     };
     res->rd_ = rd;
     res->rs0_ = rs;
-    res->name = "IFFT";
+    res->name = "MF.PREP";
     return res;
 }
 
+Instruction* Program::MfBank(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    auto res = new AiInst{path, dri, dro, [](Unit *) {}, Tag::VecCompute};
+    res->kernel_ = [res](Unit *c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rp1 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs1_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t batch = c->acc_->spec_reg_.Get(BATCH);
+
+        MatchedFilterBank(c->acc_->fft_plans_, c->acc_->pool_, rp0, rp1, len, batch, rdp);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs0;
+    res->rs1_ = rs1;
+    res->name = "MF.BANK";
+    return res;
+}
 
 Instruction* Program::Ddc(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
     auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
     res->kernel_ = [res](Unit* c) {
-        auto rdp = reinterpret_cast<float _Complex*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
         auto rp0 = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rs0_));
 
-
-        uint32_t fc = c->acc_->spec_reg_.Get(ULEN);
-        uint32_t Ts = c->acc_->spec_reg_.Get(VLEN);
+        // fc * Ts is a whole number of cycles per sample, which adds no rotation;
+        // the fractional frequency comes from the NCO tuning word.
         uint32_t x_size = c->acc_->spec_reg_.Get(X_SIZE);
-        
+        uint32_t step = c->acc_->spec_reg_.Get(NCO_STEP);
+        uint32_t phase = c->acc_->spec_reg_.Get(NCO_PHASE);
 
-        for (uint32_t i = 0; i < x_size; ++i)
- {            
-                rdp[i] = rp0[i] * cexpf(-2 * PI * I * i * fc * Ts);
-            
-        }
+        phase = NcoMix(c->acc_->pool_, rp0, x_size, phase, step, rdp);
+        c->acc_->spec_reg_.Set(NCO_PHASE, phase);
         c->pc_ += 1;
     };
     res->rd_ = rd;
@@ -2293,6 +2183,20 @@ Instruction* Program::Fir(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
         uint32_t vlen = c->acc_->spec_reg_.Get(VLEN);
         uint32_t len = ulen + vlen - 1;
 
+        // Integer taps only go through FFTs while double precision keeps every output exact.
+        if (UseFastConv(ulen, vlen, c->acc_->spec_reg_.Get(CONV_FFT_TAPS))) {
+            auto peak = [](const int32_t* p, uint32_t n) {
+                double m = 0;
+                for (uint32_t i = 0; i < n; ++i) m = std::max(m, std::fabs(double(p[i])));
+                return m;
+            };
+            if (peak(rp0, ulen) * peak(rp1, vlen) * std::min(ulen, vlen) < FastConvExactBound) {
+                FastConv<int32_t, double>(c->acc_->fft_plans_, c->acc_->pool_, rp0, ulen, rp1, vlen, rdp);
+                c->pc_ += 1;
+                return;
+            }
+        }
+
         for (uint32_t i = 0; i < len; ++i)
             rdp[i] = 0;
         for (uint32_t i = 0; i < ulen; ++i) {
@@ -2310,6 +2214,101 @@ Instruction* Program::Fir(int path, Drive dri, Drive dro, uint32_t rd, uint32_t
 }
 
 
+Instruction* Program::FirInit(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
+    res->kernel_ = [res](Unit* c) {
+        auto rdp = reinterpret_cast<FirState*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t taps = c->acc_->spec_reg_.Get(VLEN);
+        FirStateInit(rdp, rp0, taps);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "FIR.INIT";
+    return res;
+}
+
+Instruction* Program::FirStream(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
+    res->kernel_ = [res](Unit* c) {
+        auto rdp = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rp1 = reinterpret_cast<FirState*>(c->acc_->comm_reg_.Get(res->rs1_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        tai::FirStream(c->acc_->fft_plans_, c->acc_->pool_, rp1, rp0, len, rdp,
+                       c->acc_->spec_reg_.Get(CONV_FFT_TAPS));
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs0;
+    res->rs1_ = rs1;
+    res->name = "FIR.STREAM";
+    return res;
+}
+
+Instruction* Program::ChanInit(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
+    auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
+    res->kernel_ = [res](Unit* c) {
+        auto rdp = reinterpret_cast<ChanState*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rs0_));
+
+        uint32_t taps = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t channels = c->acc_->spec_reg_.Get(CHANNELS);
+        if (channels == 0) {
+            std::cerr << "SIZE ERROR: channelizer needs at least one channel" << std::endl;
+        }
+        ChanStateInit(rdp, rp0, taps, channels);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs;
+    res->name = "CHAN.INIT";
+    return res;
+}
+
+Instruction* Program::Chan(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
+    res->kernel_ = [res](Unit* c) {
+        auto rdp = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<std::complex<float>*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rp1 = reinterpret_cast<ChanState*>(c->acc_->comm_reg_.Get(res->rs1_));
+
+        uint32_t len = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t frames = Channelize(c->acc_->fft_plans_, c->acc_->pool_, rp1, rp0, len, rdp);
+        c->acc_->spec_reg_.Set(CHAN_FRAMES, frames);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs0;
+    res->rs1_ = rs1;
+    res->name = "CHAN";
+    return res;
+}
+
+Instruction* Program::FirDecim(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs0, uint32_t rs1) {
+    auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
+    res->kernel_ = [res](Unit* c) {
+        auto rdp = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rd_));
+        auto rp0 = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rs0_));
+        auto rp1 = reinterpret_cast<float*>(c->acc_->comm_reg_.Get(res->rs1_));
+
+        uint32_t ulen = c->acc_->spec_reg_.Get(ULEN);
+        uint32_t vlen = c->acc_->spec_reg_.Get(VLEN);
+        uint32_t x_size = c->acc_->spec_reg_.Get(X_SIZE);
+
+        FirDecimate(c->acc_->pool_, rp0, ulen, rp1, vlen, x_size + 1, rdp);
+        c->pc_ += 1;
+    };
+    res->rd_ = rd;
+    res->rs0_ = rs0;
+    res->rs1_ = rs1;
+    res->name = "FIR.DECIM";
+    return res;
+}
+
 Instruction* Program::Extr(int path, Drive dri, Drive dro, uint32_t rd, uint32_t rs) {
     auto res = new AiInst{ path, dri, dro, [](Unit*) {}, Tag::VecCompute };
     res->kernel_ = [res](Unit* c) {
@@ -1,5 +1,7 @@
 #include <mutex>
+#include <cstdlib>
 #include <memory>
+#include <algorithm>
 #include <iomanip>
 #include <utility>
 #include <iostream>
@@ -8,6 +10,20 @@
 
 using namespace tai;
 
+namespace {
+    // One worker per hardware thread besides the caller. TAI_WORKERS in the environment sets
+    // the count instead, so the threaded paths can be tested on a single-core host and
+    // TAI_WORKERS=0 runs everything inline.
+    uint32_t PoolWorkers() {
+        if (const char* env = getenv("TAI_WORKERS")) {
+            char* end = nullptr;
+            unsigned long n = strtoul(env, &end, 10);
+            if (end != env && *end == '\0') return static_cast<uint32_t>(std::min(n, 256ul));
+        }
+        return std::max(1u, std::thread::hardware_concurrency()) - 1;
+    }
+}
+
 Accelerator::Accelerator():
         spec_reg_(NumSpecRegs, {PEGRESS, AEGRESS, MEGRESS}),
         comm_reg_(NumCommonRegs),
@@ -16,7 +32,8 @@ Accelerator::Accelerator():
         tmp_(32 * 1024 * 1024),
         cu_(this),
         mpu_(this),
-        lsu_(this) {
+        lsu_(this),
+        pool_(PoolWorkers()) {
 }
 
 Accelerator::~Accelerator() = default;
@@ -277,6 +294,77 @@ bool LSU::Running() {
              (sync_->write_queue_.empty() && sync_->write_done_));
 }
 
+namespace {
+    // Set on pool workers, a nested ParallelFor from inside a task runs inline.
+    thread_local bool in_pool_worker = false;
+}
+
+Pool::Pool(uint32_t workers) {
+    for (uint32_t w = 0; w != workers; ++w) {
+        workers_.emplace_back([this] {
+            in_pool_worker = true;
+            uint64_t seen = 0;
+            for (;;) {
+                std::unique_lock<std::mutex> lk(mtx_);
+                while (!shutdown_ && generation_ == seen) {
+                    cond_.wait(lk);
+                }
+                if (shutdown_) break;
+                seen = generation_;
+                lk.unlock();
+                Drain();
+                lk.lock();
+                if (--active_ == 0) {
+                    done_cond_.notify_one();
+                }
+            }
+        });
+    }
+}
+
+Pool::~Pool() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        shutdown_ = true;
+    }
+    cond_.notify_all();
+    for (auto& t : workers_) {
+        t.join();
+    }
+}
+
+void Pool::Drain() {
+    for (;;) {
+        uint32_t i = next_.fetch_add(1);
+        if (i >= total_) break;
+        (*job_)(i);
+    }
+}
+
+void Pool::ParallelFor(uint32_t n, const std::function<void(uint32_t)>& fn) {
+    if (n == 0) return;
+    if (workers_.empty() || n == 1 || in_pool_worker) {
+        for (uint32_t i = 0; i != n; ++i) fn(i);
+        return;
+    }
+    std::lock_guard<std::mutex> call(call_mtx_);
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        job_ = &fn;
+        total_ = n;
+        next_ = 0;
+        active_ = static_cast<uint32_t>(workers_.size());
+        ++generation_;
+    }
+    cond_.notify_all();
+    Drain();
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (active_ != 0) {
+        done_cond_.wait(lk);
+    }
+    job_ = nullptr;
+}
+
 DRAM::DRAM(uint32_t nbytes) {
     this->nbytes = nbytes;
     data = new uint8_t[nbytes];
@@ -0,0 +1,837 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "../include/tai_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TAI_SIMD_X86 1
+#endif
+
+using namespace tai;
+
+namespace {
+
+    // Plain C++ kernels: the fallback and the tails of the vector loops.
+    template <typename T>
+    void MulScalar(const T* a, const T* b, T* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            const T ar = a[2 * i], ai = a[2 * i + 1], br = b[2 * i], bi = b[2 * i + 1];
+            out[2 * i] = ar * br - ai * bi;
+            out[2 * i + 1] = ar * bi + ai * br;
+        }
+    }
+
+    template <typename T>
+    void MuliScalar(const T* a, T re, T im, T* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            const T ar = a[2 * i], ai = a[2 * i + 1];
+            out[2 * i] = ar * re - ai * im;
+            out[2 * i + 1] = ar * im + ai * re;
+        }
+    }
+
+    template <typename T>
+    void SubScalar(const T* a, const T* b, T* out, size_t n) {
+        for (size_t i = 0; i < 2 * n; ++i) out[i] = a[i] - b[i];
+    }
+
+    template <typename T>
+    void ConjScalar(const T* a, T* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[2 * i] = a[2 * i];
+            out[2 * i + 1] = -a[2 * i + 1];
+        }
+    }
+
+    template <typename T>
+    void AbsScalar(const T* a, T* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = std::hypot(a[2 * i], a[2 * i + 1]);
+    }
+
+    // Q15 product rounded like pmulhrsw.
+    inline int16_t MulQ15(int16_t a, int16_t b) {
+        return static_cast<int16_t>((static_cast<int32_t>(a) * b + 0x4000) >> 15);
+    }
+
+    inline int16_t SatAdd(int32_t a, int32_t b) {
+        return static_cast<int16_t>(std::max(-32768, std::min(32767, a + b)));
+    }
+
+    uint32_t FftStageI16Scalar(int16_t* x, uint32_t n, uint32_t half, const int16_t* tw_re,
+                               const int16_t* tw_im, int shift) {
+        const int16_t scale = shift ? static_cast<int16_t>(1 << (15 - shift)) : 0;
+        uint32_t peak = 0;
+        for (uint32_t g = 0; g < n; g += 2 * half) {
+            for (uint32_t k = 0; k < half; ++k) {
+                int16_t* p = x + 2 * (g + k);
+                int16_t* q = p + 2 * half;
+                int16_t ar = p[0], ai = p[1], br = q[0], bi = q[1];
+                if (shift) {
+                    ar = MulQ15(ar, scale);
+                    ai = MulQ15(ai, scale);
+                    br = MulQ15(br, scale);
+                    bi = MulQ15(bi, scale);
+                }
+                // The only twiddle of the first stage is exactly 1.
+                int16_t tr = br, ti = bi;
+                if (half > 1) {
+                    tr = SatAdd(MulQ15(br, tw_re[2 * k]), MulQ15(bi, tw_im[2 * k]));
+                    ti = SatAdd(MulQ15(bi, tw_re[2 * k + 1]), MulQ15(br, tw_im[2 * k + 1]));
+                }
+                p[0] = SatAdd(ar, tr);
+                p[1] = SatAdd(ai, ti);
+                q[0] = SatAdd(ar, -tr);
+                q[1] = SatAdd(ai, -ti);
+                for (int16_t v : {p[0], p[1], q[0], q[1]}) peak = std::max<uint32_t>(peak, std::abs(int32_t(v)));
+            }
+        }
+        return peak;
+    }
+
+    // exp and log10 on GCC vector types of W lanes, force-inlined into per-ISA kernels that fix
+    // the register width. exp: Cody-Waite reduction to |r| <= ln2 / 2, then the Cephes expf
+    // polynomial or the Taylor series to r^13 for double. log10: x = m * 2^e with m near 1 and
+    // the atanh series in s = (m - 1) / (m + 1) as in fdlibm. The fast variants cut the series
+    // short. Measured against long double: at most 1.8 ULP, fast 4e-6 / 5e-9 relative.
+    template <typename T>
+    struct MathBits;
+
+    template <>
+    struct MathBits<float> {
+        using I = int32_t;
+        static constexpr int Mant = 23;
+        static constexpr I Bias = 127;
+        static constexpr float Magic = 12582912.0f;  // 1.5 * 2^23
+    };
+
+    template <>
+    struct MathBits<double> {
+        using I = int64_t;
+        static constexpr int Mant = 52;
+        static constexpr I Bias = 1023;
+        static constexpr double Magic = 6755399441055744.0;  // 1.5 * 2^52
+    };
+
+    template <typename T, int W>
+    struct Lanes {
+        typedef T V __attribute__((vector_size(sizeof(T) * W)));
+        typedef typename MathBits<T>::I I __attribute__((vector_size(sizeof(T) * W)));
+    };
+
+    // The helpers below take and return vectors by reference: they are always inlined into
+    // the target-attributed kernels, and a vector passed by value from a function without
+    // that attribute would change the ABI (-Wpsabi).
+    template <typename V, typename T>
+    __attribute__((always_inline)) inline void Horner(const V& x, const T* c, int n, V& p) {
+        p = V{} + c[0];
+        for (int k = 1; k < n; ++k) {
+            p = p * x + c[k];
+        }
+    }
+
+    // 2^n for the integers n held in t - Magic, as two factors so that results down to the
+    // subnormal range are rounded only once.
+    template <typename T, int W>
+    __attribute__((always_inline)) inline void Pow2(const typename Lanes<T, W>::V& nd, typename Lanes<T, W>::V& s1,
+                                                  typename Lanes<T, W>::V& s2) {
+        using B = MathBits<T>;
+        using V = typename Lanes<T, W>::V;
+        using I = typename Lanes<T, W>::I;
+        const I magic = (I)(V{} + B::Magic);
+        V n1d = nd * T(0.5) + B::Magic;
+        I n1 = (I)n1d - magic;
+        I n = (I)(nd + B::Magic) - magic;
+        s1 = (V)((n1 + B::Bias) << B::Mant);
+        s2 = (V)((n - n1 + B::Bias) << B::Mant);
+    }
+
+    template <typename T, int W, bool Fast>
+    __attribute__((always_inline)) inline void ExpLanes(const typename Lanes<T, W>::V& x, typename Lanes<T, W>::V& out) {
+        using B = MathBits<T>;
+        using V = typename Lanes<T, W>::V;
+        constexpr bool F32 = sizeof(T) == 4;
+        const T lo = F32 ? -104.0f : -746.0, hi = F32 ? 89.0f : 710.0;
+        const T ln2_hi = F32 ? 0.693359375f : 6.93147180369123816490e-01;
+        const T ln2_lo = F32 ? -2.12194440e-4f : 1.90821492927058770002e-10;
+        const T log2e = F32 ? 1.44269504088896341f : 1.44269504088896341;
+
+        V y = x < lo ? V{} + lo : x;
+        y = y > hi ? V{} + hi : y;
+        V nd = (y * log2e + B::Magic) - B::Magic;
+        V r = (y - nd * ln2_hi) - nd * ln2_lo;
+
+        V p;
+        if constexpr (F32 && !Fast) {
+            static const T c[] = {T(1.9875691500E-4), T(1.3981999507E-3), T(8.3334519073E-3),
+                                  T(4.1665795894E-2), T(1.6666665459E-1), T(5.0000001201E-1)};
+            Horner(r, c, 6, p);
+            p = p * (r * r) + r + T(1);
+        } else if constexpr (F32) {
+            static const T c[] = {T(1.0 / 120), T(1.0 / 24), T(1.0 / 6), T(0.5), T(1), T(1)};
+            Horner(r, c, 6, p);
+        } else if constexpr (!Fast) {
+            static const T c[] = {1.0 / 6227020800, 1.0 / 479001600, 1.0 / 39916800, 1.0 / 3628800,
+                                  1.0 / 362880, 1.0 / 40320, 1.0 / 5040, 1.0 / 720, 1.0 / 120,
+                                  1.0 / 24, 1.0 / 6, 0.5, 1, 1};
+            Horner(r, c, 14, p);
+        } else {
+            static const T c[] = {1.0 / 5040, 1.0 / 720, 1.0 / 120, 1.0 / 24, 1.0 / 6, 0.5, 1, 1};
+            Horner(r, c, 8, p);
+        }
+
+        V s1, s2;
+        Pow2<T, W>(nd, s1, s2);
+        V res = p * s1 * s2;
+        out = x != x ? x : res;
+    }
+
+    template <typename T, int W, bool Fast>
+    __attribute__((always_inline)) inline void Log10Lanes(const typename Lanes<T, W>::V& x, typename Lanes<T, W>::V& out) {
+        using B = MathBits<T>;
+        using V = typename Lanes<T, W>::V;
+        using I = typename Lanes<T, W>::I;
+        constexpr bool F32 = sizeof(T) == 4;
+        const T min_normal = F32 ? 1.17549435e-38f : 2.2250738585072014e-308;
+        const T sub_scale = F32 ? 33554432.0f : 18014398509481984.0;  // 2^25, 2^54
+        const T sub_exp = F32 ? 25 : 54;
+        const T sqrt2 = F32 ? 1.41421356f : 1.4142135623730951;
+        const T ivln10 = F32 ? 4.3429449201e-01f : 4.34294481903251816668e-01;
+        const T log10_2hi = F32 ? 3.0102920532e-01f : 3.01029995663611771306e-01;
+        const T log10_2lo = F32 ? 7.9034151668e-07f : 3.69423907715893078616e-13;
+        const T inf = std::numeric_limits<T>::infinity();
+
+        auto sub = x < min_normal;
+        V y = sub ? x * sub_scale : x;
+        I bits = (I)y;
+        // biased exponent as T: OR it under the exponent of 2^Mant and subtract
+        const I e_bits = (bits >> B::Mant) & (2 * B::Bias + 1);
+        const V two_mant = V{} + (F32 ? T(8388608.0f) : T(4503599627370496.0));
+        V e = ((V)(e_bits | (I)two_mant) - two_mant) - T(B::Bias);
+        e = sub ? e - sub_exp : e;
+        const I mant_mask = I{} + ((typename B::I(1) << B::Mant) - 1);
+        V m = (V)((bits & mant_mask) | (I)(V{} + T(1)));
+        auto big = m > sqrt2;
+        m = big ? m * T(0.5) : m;
+        e = big ? e + T(1) : e;
+
+        V f = m - T(1);
+        V s = f / (f + T(2));
+        V z = s * s;
+        V R;
+        if constexpr (F32 && !Fast) {
+            static const T c[] = {T(2.0 / 9), T(2.0 / 7), T(2.0 / 5), T(2.0 / 3)};
+            Horner(z, c, 4, R);
+            R = z * R;
+        } else if constexpr (F32) {
+            static const T c[] = {T(2.0 / 5), T(2.0 / 3)};
+            Horner(z, c, 2, R);
+            R = z * R;
+        } else if constexpr (!Fast) {
+            static const T c[] = {2.0 / 21, 2.0 / 19, 2.0 / 17, 2.0 / 15, 2.0 / 13,
+                                  2.0 / 11, 2.0 / 9, 2.0 / 7, 2.0 / 5, 2.0 / 3};
+            Horner(z, c, 10, R);
+            R = z * R;
+        } else {
+            static const T c[] = {2.0 / 9, 2.0 / 7, 2.0 / 5, 2.0 / 3};
+            Horner(z, c, 4, R);
+            R = z * R;
+        }
+        V hfsq = T(0.5) * f * f;
+        V ln = f - (hfsq - s * (hfsq + R));
+        V res = e * log10_2hi + (e * log10_2lo + ln * ivln10);
+
+        res = x < T(0) ? V{} + std::numeric_limits<T>::quiet_NaN() : res;
+        res = x == T(0) ? V{} - inf : res;
+        res = x == inf ? V{} + inf : res;
+        out = x != x ? x : res;
+    }
+
+    enum class MathFn { Exp, Log10 };
+
+    // out[0, W) = fn(in[0, W)).
+    template <typename T, int W, MathFn Fn, bool Fast>
+    __attribute__((always_inline)) inline void MathLanes(const T* in, T* out) {
+        using V = typename Lanes<T, W>::V;
+        V x;
+        __builtin_memcpy(&x, in, sizeof(V));
+        V y;
+        if constexpr (Fn == MathFn::Exp) {
+            ExpLanes<T, W, Fast>(x, y);
+        } else {
+            Log10Lanes<T, W, Fast>(x, y);
+        }
+        __builtin_memcpy(out, &y, sizeof(V));
+    }
+
+    // out[i] = fn(a[i]) W lanes at a time, the tail through a padded block.
+    template <typename T, int W, MathFn Fn, bool Fast>
+    __attribute__((always_inline)) inline void MathLoop(const T* a, T* out, size_t n) {
+        size_t i = 0;
+        for (; i + W <= n; i += W) {
+            MathLanes<T, W, Fn, Fast>(a + i, out + i);
+        }
+        if (i < n) {
+            T x[W], y[W];
+            std::fill(x, x + W, T(1));
+            std::copy(a + i, a + n, x);
+            MathLanes<T, W, Fn, Fast>(x, y);
+            std::copy(y, y + (n - i), out + i);
+        }
+    }
+
+    template <typename T, int W, MathFn Fn>
+    __attribute__((always_inline)) inline void MathKernel(const T* a, T* out, size_t n, bool fast) {
+        if (fast) {
+            MathLoop<T, W, Fn, true>(a, out, n);
+        } else {
+            MathLoop<T, W, Fn, false>(a, out, n);
+        }
+    }
+
+    // GEMM register block: MR rows of NV vectors of W lanes stay in registers while the packed
+    // panels stream past, one broadcast element of a against NV loads of b per row and step.
+    template <typename T, int W, int MR, int NV>
+    __attribute__((always_inline)) inline void GemmBlock(size_t k, const T* a, const T* b, T* c, size_t ldc,
+                                                         bool accumulate) {
+        typedef T V __attribute__((vector_size(sizeof(T) * W)));
+        constexpr int NR = NV * W;
+        V acc[MR][NV];
+#pragma GCC unroll 16
+        for (int i = 0; i < MR; ++i) {
+#pragma GCC unroll 4
+            for (int v = 0; v < NV; ++v) {
+                acc[i][v] = V{};
+            }
+        }
+        for (size_t l = 0; l < k; ++l) {
+            V bv[NV];
+#pragma GCC unroll 4
+            for (int v = 0; v < NV; ++v) {
+                __builtin_memcpy(&bv[v], b + l * NR + v * W, sizeof(V));
+            }
+#pragma GCC unroll 16
+            for (int i = 0; i < MR; ++i) {
+                V av = a[l * MR + i] - V{};  // a broadcast; x - 0 folds away where 0 + x does not
+#pragma GCC unroll 4
+                for (int v = 0; v < NV; ++v) {
+                    acc[i][v] += av * bv[v];
+                }
+            }
+        }
+#pragma GCC unroll 16
+        for (int i = 0; i < MR; ++i) {
+#pragma GCC unroll 4
+            for (int v = 0; v < NV; ++v) {
+                V out = acc[i][v];
+                if (accumulate) {
+                    V old;
+                    __builtin_memcpy(&old, c + i * ldc + v * W, sizeof(V));
+                    out += old;
+                }
+                __builtin_memcpy(c + i * ldc + v * W, &out, sizeof(V));
+            }
+        }
+    }
+
+    // Portable instances, plain SSE2 on x86-64.
+    void ExpF32Generic(const float* a, float* out, size_t n, bool fast) { MathKernel<float, 4, MathFn::Exp>(a, out, n, fast); }
+    void ExpF64Generic(const double* a, double* out, size_t n, bool fast) { MathKernel<double, 2, MathFn::Exp>(a, out, n, fast); }
+    void Log10F32Generic(const float* a, float* out, size_t n, bool fast) { MathKernel<float, 4, MathFn::Log10>(a, out, n, fast); }
+    void Log10F64Generic(const double* a, double* out, size_t n, bool fast) { MathKernel<double, 2, MathFn::Log10>(a, out, n, fast); }
+    void GemmF32Generic(size_t k, const float* a, const float* b, float* c, size_t ldc, bool acc) { GemmBlock<float, 4, 4, 2>(k, a, b, c, ldc, acc); }
+    void GemmF64Generic(size_t k, const double* a, const double* b, double* c, size_t ldc, bool acc) { GemmBlock<double, 2, 4, 2>(k, a, b, c, ldc, acc); }
+    void GemmI32Generic(size_t k, const int32_t* a, const int32_t* b, int32_t* c, size_t ldc, bool acc) { GemmBlock<int32_t, 4, 4, 2>(k, a, b, c, ldc, acc); }
+
+#ifdef TAI_SIMD_X86
+
+    // SSE3: one float complex pair or one double complex per register.
+    __attribute__((target("sse3")))
+    void MulC32Sse(const float* a, const float* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128 x = _mm_loadu_ps(a + 2 * i), y = _mm_loadu_ps(b + 2 * i);
+            __m128 t = _mm_mul_ps(_mm_shuffle_ps(x, x, 0xB1), _mm_movehdup_ps(y));
+            _mm_storeu_ps(out + 2 * i, _mm_addsub_ps(_mm_mul_ps(x, _mm_moveldup_ps(y)), t));
+        }
+        MulScalar(a + 2 * i, b + 2 * i, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("sse3")))
+    void MuliC32Sse(const float* a, float re, float im, float* out, size_t n) {
+        const __m128 vr = _mm_set1_ps(re), vi = _mm_set1_ps(im);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128 x = _mm_loadu_ps(a + 2 * i);
+            __m128 t = _mm_mul_ps(_mm_shuffle_ps(x, x, 0xB1), vi);
+            _mm_storeu_ps(out + 2 * i, _mm_addsub_ps(_mm_mul_ps(x, vr), t));
+        }
+        MuliScalar(a + 2 * i, re, im, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("sse3")))
+    void SubC32Sse(const float* a, const float* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= 2 * n; i += 4) {
+            _mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        SubScalar(a + i, b + i, out + i, (2 * n - i) / 2);
+    }
+
+    __attribute__((target("sse3")))
+    void ConjC32Sse(const float* a, float* out, size_t n) {
+        const __m128 sign = _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, 0, INT32_MIN, 0));
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            _mm_storeu_ps(out + 2 * i, _mm_xor_ps(_mm_loadu_ps(a + 2 * i), sign));
+        }
+        ConjScalar(a + 2 * i, out + 2 * i, n - i);
+    }
+
+    // |z| of float data is computed in double, so it neither overflows nor underflows.
+    __attribute__((target("sse3")))
+    void AbsC32Sse(const float* a, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128 x = _mm_loadu_ps(a + 2 * i);
+            __m128d lo = _mm_cvtps_pd(x), hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+            __m128d s = _mm_hadd_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi));
+            __m128 r = _mm_cvtpd_ps(_mm_sqrt_pd(s));
+            _mm_storel_pi(reinterpret_cast<__m64*>(out + i), r);
+        }
+        AbsScalar(a + 2 * i, out + i, n - i);
+    }
+
+    __attribute__((target("sse3")))
+    void MulC64Sse(const double* a, const double* b, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            __m128d x = _mm_loadu_pd(a + 2 * i), y = _mm_loadu_pd(b + 2 * i);
+            __m128d t = _mm_mul_pd(_mm_shuffle_pd(x, x, 1), _mm_unpackhi_pd(y, y));
+            _mm_storeu_pd(out + 2 * i, _mm_addsub_pd(_mm_mul_pd(x, _mm_movedup_pd(y)), t));
+        }
+    }
+
+    __attribute__((target("sse3")))
+    void MuliC64Sse(const double* a, double re, double im, double* out, size_t n) {
+        const __m128d vr = _mm_set1_pd(re), vi = _mm_set1_pd(im);
+        for (size_t i = 0; i < n; ++i) {
+            __m128d x = _mm_loadu_pd(a + 2 * i);
+            __m128d t = _mm_mul_pd(_mm_shuffle_pd(x, x, 1), vi);
+            _mm_storeu_pd(out + 2 * i, _mm_addsub_pd(_mm_mul_pd(x, vr), t));
+        }
+    }
+
+    __attribute__((target("sse3")))
+    void SubC64Sse(const double* a, const double* b, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            _mm_storeu_pd(out + 2 * i, _mm_sub_pd(_mm_loadu_pd(a + 2 * i), _mm_loadu_pd(b + 2 * i)));
+        }
+    }
+
+    __attribute__((target("sse3")))
+    void ConjC64Sse(const double* a, double* out, size_t n) {
+        const __m128d sign = _mm_set_pd(-0.0, 0.0);
+        for (size_t i = 0; i < n; ++i) {
+            _mm_storeu_pd(out + 2 * i, _mm_xor_pd(_mm_loadu_pd(a + 2 * i), sign));
+        }
+    }
+
+    // Components this far from 1 could overflow or underflow the sum of squares,
+    // such elements go through hypot instead. The others get sqrt(re^2 + im^2), within
+    // 1 ulp of hypot.
+    constexpr double AbsBig = 1e150, AbsSmall = 1e-150;
+
+    __attribute__((target("sse3")))
+    void AbsC64Sse(const double* a, double* out, size_t n) {
+        const __m128d mask = _mm_castsi128_pd(_mm_set1_epi64x(INT64_MAX));
+        const __m128d big = _mm_set1_pd(AbsBig), small = _mm_set1_pd(AbsSmall), zero = _mm_setzero_pd();
+        for (size_t i = 0; i < n; ++i) {
+            __m128d x = _mm_loadu_pd(a + 2 * i);
+            __m128d m = _mm_and_pd(x, mask);
+            __m128d bad = _mm_or_pd(_mm_cmpgt_pd(m, big),
+                                    _mm_and_pd(_mm_cmplt_pd(m, small), _mm_cmpneq_pd(m, zero)));
+            if (_mm_movemask_pd(bad)) {
+                out[i] = std::hypot(a[2 * i], a[2 * i + 1]);
+                continue;
+            }
+            __m128d s = _mm_mul_pd(x, x);
+            out[i] = _mm_cvtsd_f64(_mm_sqrt_sd(s, _mm_hadd_pd(s, s)));
+        }
+    }
+
+    // AVX2 + FMA: four float or two double complex elements per register. fmaddsub rounds
+    // ar * br - ai * bi once instead of three times, see the tolerance in tai_simd.h.
+    __attribute__((target("avx2,fma")))
+    void MulC32Avx2(const float* a, const float* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256 x = _mm256_loadu_ps(a + 2 * i), y = _mm256_loadu_ps(b + 2 * i);
+            __m256 t = _mm256_mul_ps(_mm256_permute_ps(x, 0xB1), _mm256_movehdup_ps(y));
+            _mm256_storeu_ps(out + 2 * i, _mm256_fmaddsub_ps(x, _mm256_moveldup_ps(y), t));
+        }
+        MulScalar(a + 2 * i, b + 2 * i, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void MuliC32Avx2(const float* a, float re, float im, float* out, size_t n) {
+        const __m256 vr = _mm256_set1_ps(re), vi = _mm256_set1_ps(im);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256 x = _mm256_loadu_ps(a + 2 * i);
+            __m256 t = _mm256_mul_ps(_mm256_permute_ps(x, 0xB1), vi);
+            _mm256_storeu_ps(out + 2 * i, _mm256_fmaddsub_ps(x, vr, t));
+        }
+        MuliScalar(a + 2 * i, re, im, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void SubC32Avx2(const float* a, const float* b, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= 2 * n; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        SubScalar(a + i, b + i, out + i, (2 * n - i) / 2);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void ConjC32Avx2(const float* a, float* out, size_t n) {
+        const __m256 sign = _mm256_castsi256_ps(_mm256_set_epi32(INT32_MIN, 0, INT32_MIN, 0,
+                                                                 INT32_MIN, 0, INT32_MIN, 0));
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_ps(out + 2 * i, _mm256_xor_ps(_mm256_loadu_ps(a + 2 * i), sign));
+        }
+        ConjScalar(a + 2 * i, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void AbsC32Avx2(const float* a, float* out, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d lo = _mm256_cvtps_pd(_mm_loadu_ps(a + 2 * i));
+            __m256d hi = _mm256_cvtps_pd(_mm_loadu_ps(a + 2 * i + 4));
+            // hadd interleaves the two halves: |z0|^2 |z2|^2 |z1|^2 |z3|^2
+            __m256d s = _mm256_hadd_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi));
+            s = _mm256_permute4x64_pd(s, 0xD8);
+            _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_sqrt_pd(s)));
+        }
+        AbsScalar(a + 2 * i, out + i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void MulC64Avx2(const double* a, const double* b, double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256d x = _mm256_loadu_pd(a + 2 * i), y = _mm256_loadu_pd(b + 2 * i);
+            __m256d t = _mm256_mul_pd(_mm256_permute_pd(x, 0x5), _mm256_permute_pd(y, 0xF));
+            _mm256_storeu_pd(out + 2 * i, _mm256_fmaddsub_pd(x, _mm256_movedup_pd(y), t));
+        }
+        MulScalar(a + 2 * i, b + 2 * i, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void MuliC64Avx2(const double* a, double re, double im, double* out, size_t n) {
+        const __m256d vr = _mm256_set1_pd(re), vi = _mm256_set1_pd(im);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256d x = _mm256_loadu_pd(a + 2 * i);
+            __m256d t = _mm256_mul_pd(_mm256_permute_pd(x, 0x5), vi);
+            _mm256_storeu_pd(out + 2 * i, _mm256_fmaddsub_pd(x, vr, t));
+        }
+        MuliScalar(a + 2 * i, re, im, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void SubC64Avx2(const double* a, const double* b, double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_pd(out + 2 * i, _mm256_sub_pd(_mm256_loadu_pd(a + 2 * i), _mm256_loadu_pd(b + 2 * i)));
+        }
+        SubScalar(a + 2 * i, b + 2 * i, out + 2 * i, n - i);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void ConjC64Avx2(const double* a, double* out, size_t n) {
+        const __m256d sign = _mm256_set_pd(-0.0, 0.0, -0.0, 0.0);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_pd(out + 2 * i, _mm256_xor_pd(_mm256_loadu_pd(a + 2 * i), sign));
+        }
+        ConjScalar(a + 2 * i, out + 2 * i, n - i);
+    }
+
+    // Eight complex int16 per register. Stages with half < 8 pair lanes inside a register:
+    // lane j meets lane j ^ half, the lower one keeps a + w * b and the upper one a - w * b.
+    __attribute__((target("avx2,fma")))
+    uint32_t FftStageI16Avx2(int16_t* x, uint32_t n, uint32_t half, const int16_t* tw_re,
+                             const int16_t* tw_im, int shift) {
+        if (n < 8) return FftStageI16Scalar(x, n, half, tw_re, tw_im, shift);
+        const __m256i swap = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                              2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+        const __m256i scale = _mm256_set1_epi16(shift ? static_cast<int16_t>(1 << (15 - shift)) : 0);
+        __m256i peak = _mm256_setzero_si256();
+        if (half < 8) {
+            alignas(32) int16_t wr_lane[16], wi_lane[16];
+            alignas(32) int32_t partner[8], upper[8];
+            for (uint32_t j = 0; j < 8; ++j) {
+                const uint32_t k = j % half;
+                wr_lane[2 * j] = tw_re[2 * k];
+                wr_lane[2 * j + 1] = tw_re[2 * k + 1];
+                wi_lane[2 * j] = tw_im[2 * k];
+                wi_lane[2 * j + 1] = tw_im[2 * k + 1];
+                partner[j] = j ^ half;
+                upper[j] = (j & half) ? -1 : 0;
+            }
+            const __m256i wr = _mm256_load_si256(reinterpret_cast<const __m256i*>(wr_lane));
+            const __m256i wi = _mm256_load_si256(reinterpret_cast<const __m256i*>(wi_lane));
+            const __m256i idx = _mm256_load_si256(reinterpret_cast<const __m256i*>(partner));
+            const __m256i up = _mm256_load_si256(reinterpret_cast<const __m256i*>(upper));
+            for (uint32_t j = 0; j < n; j += 8) {
+                auto p = reinterpret_cast<__m256i*>(x + 2 * j);
+                __m256i v = _mm256_loadu_si256(p);
+                if (shift) v = _mm256_mulhrs_epi16(v, scale);
+                const __m256i o = _mm256_permutevar8x32_epi32(v, idx);
+                const __m256i a = _mm256_blendv_epi8(v, o, up);
+                __m256i b = _mm256_blendv_epi8(o, v, up);
+                if (half > 1) {
+                    b = _mm256_adds_epi16(_mm256_mulhrs_epi16(b, wr),
+                                          _mm256_mulhrs_epi16(_mm256_shuffle_epi8(b, swap), wi));
+                }
+                const __m256i r = _mm256_blendv_epi8(_mm256_adds_epi16(a, b), _mm256_subs_epi16(a, b), up);
+                _mm256_storeu_si256(p, r);
+                peak = _mm256_max_epu16(peak, _mm256_abs_epi16(r));
+            }
+        }
+        for (uint32_t g = 0; half >= 8 && g < n; g += 2 * half) {
+            for (uint32_t k = 0; k < half; k += 8) {
+                auto p = reinterpret_cast<__m256i*>(x + 2 * (g + k));
+                auto q = reinterpret_cast<__m256i*>(x + 2 * (g + k + half));
+                __m256i a = _mm256_loadu_si256(p), b = _mm256_loadu_si256(q);
+                if (shift) {
+                    a = _mm256_mulhrs_epi16(a, scale);
+                    b = _mm256_mulhrs_epi16(b, scale);
+                }
+                const __m256i wr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tw_re + 2 * k));
+                const __m256i wi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tw_im + 2 * k));
+                const __m256i t = _mm256_adds_epi16(_mm256_mulhrs_epi16(b, wr),
+                                                    _mm256_mulhrs_epi16(_mm256_shuffle_epi8(b, swap), wi));
+                const __m256i hi = _mm256_adds_epi16(a, t), lo = _mm256_subs_epi16(a, t);
+                _mm256_storeu_si256(p, hi);
+                _mm256_storeu_si256(q, lo);
+                peak = _mm256_max_epu16(peak, _mm256_max_epu16(_mm256_abs_epi16(hi), _mm256_abs_epi16(lo)));
+            }
+        }
+        __m128i m = _mm_max_epu16(_mm256_castsi256_si128(peak), _mm256_extracti128_si256(peak, 1));
+        m = _mm_max_epu16(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epu16(m, _mm_srli_si128(m, 4));
+        m = _mm_max_epu16(m, _mm_srli_si128(m, 2));
+        return static_cast<uint16_t>(_mm_cvtsi128_si32(m));
+    }
+
+    // AVX-512: eight float or four double complex elements per register, tails are masked.
+    // The unmasked permutes start from _mm512_undefined_*, which GCC 12 reports under
+    // -Wmaybe-uninitialized once inlined; the all-ones masked forms below are the same instructions.
+    __attribute__((target("avx512f"), always_inline))
+    inline __m512 SwapPs(__m512 x) { return _mm512_mask_permute_ps(x, 0xFFFF, x, 0xB1); }
+    __attribute__((target("avx512f"), always_inline))
+    inline __m512 OddPs(__m512 x) { return _mm512_mask_movehdup_ps(x, 0xFFFF, x); }
+    __attribute__((target("avx512f"), always_inline))
+    inline __m512 EvenPs(__m512 x) { return _mm512_mask_moveldup_ps(x, 0xFFFF, x); }
+    __attribute__((target("avx512f"), always_inline))
+    inline __m512d SwapPd(__m512d x) { return _mm512_mask_permute_pd(x, 0xFF, x, 0x55); }
+    __attribute__((target("avx512f"), always_inline))
+    inline __m512d OddPd(__m512d x) { return _mm512_mask_permute_pd(x, 0xFF, x, 0xFF); }
+    __attribute__((target("avx512f"), always_inline))
+    inline __m512d EvenPd(__m512d x) { return _mm512_mask_movedup_pd(x, 0xFF, x); }
+
+    __attribute__((target("avx512f")))
+    void MulC32Avx512(const float* a, const float* b, float* out, size_t n) {
+        for (size_t i = 0; i < n; i += 8) {
+            const __mmask16 k = n - i >= 8 ? 0xFFFF : static_cast<__mmask16>((1u << (2 * (n - i))) - 1);
+            __m512 x = _mm512_maskz_loadu_ps(k, a + 2 * i), y = _mm512_maskz_loadu_ps(k, b + 2 * i);
+            __m512 t = _mm512_mul_ps(SwapPs(x), OddPs(y));
+            _mm512_mask_storeu_ps(out + 2 * i, k, _mm512_fmaddsub_ps(x, EvenPs(y), t));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void MuliC32Avx512(const float* a, float re, float im, float* out, size_t n) {
+        const __m512 vr = _mm512_set1_ps(re), vi = _mm512_set1_ps(im);
+        for (size_t i = 0; i < n; i += 8) {
+            const __mmask16 k = n - i >= 8 ? 0xFFFF : static_cast<__mmask16>((1u << (2 * (n - i))) - 1);
+            __m512 x = _mm512_maskz_loadu_ps(k, a + 2 * i);
+            __m512 t = _mm512_mul_ps(SwapPs(x), vi);
+            _mm512_mask_storeu_ps(out + 2 * i, k, _mm512_fmaddsub_ps(x, vr, t));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void SubC32Avx512(const float* a, const float* b, float* out, size_t n) {
+        for (size_t i = 0; i < n; i += 8) {
+            const __mmask16 k = n - i >= 8 ? 0xFFFF : static_cast<__mmask16>((1u << (2 * (n - i))) - 1);
+            __m512 d = _mm512_sub_ps(_mm512_maskz_loadu_ps(k, a + 2 * i), _mm512_maskz_loadu_ps(k, b + 2 * i));
+            _mm512_mask_storeu_ps(out + 2 * i, k, d);
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void ConjC32Avx512(const float* a, float* out, size_t n) {
+        const __m512i sign = _mm512_set1_epi64(static_cast<int64_t>(0x8000000000000000ull));
+        for (size_t i = 0; i < n; i += 8) {
+            const __mmask16 k = n - i >= 8 ? 0xFFFF : static_cast<__mmask16>((1u << (2 * (n - i))) - 1);
+            __m512i x = _mm512_castps_si512(_mm512_maskz_loadu_ps(k, a + 2 * i));
+            _mm512_mask_storeu_ps(out + 2 * i, k, _mm512_castsi512_ps(_mm512_xor_si512(x, sign)));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void MulC64Avx512(const double* a, const double* b, double* out, size_t n) {
+        for (size_t i = 0; i < n; i += 4) {
+            const __mmask8 k = n - i >= 4 ? 0xFF : static_cast<__mmask8>((1u << (2 * (n - i))) - 1);
+            __m512d x = _mm512_maskz_loadu_pd(k, a + 2 * i), y = _mm512_maskz_loadu_pd(k, b + 2 * i);
+            __m512d t = _mm512_mul_pd(SwapPd(x), OddPd(y));
+            _mm512_mask_storeu_pd(out + 2 * i, k, _mm512_fmaddsub_pd(x, EvenPd(y), t));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void MuliC64Avx512(const double* a, double re, double im, double* out, size_t n) {
+        const __m512d vr = _mm512_set1_pd(re), vi = _mm512_set1_pd(im);
+        for (size_t i = 0; i < n; i += 4) {
+            const __mmask8 k = n - i >= 4 ? 0xFF : static_cast<__mmask8>((1u << (2 * (n - i))) - 1);
+            __m512d x = _mm512_maskz_loadu_pd(k, a + 2 * i);
+            __m512d t = _mm512_mul_pd(SwapPd(x), vi);
+            _mm512_mask_storeu_pd(out + 2 * i, k, _mm512_fmaddsub_pd(x, vr, t));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void SubC64Avx512(const double* a, const double* b, double* out, size_t n) {
+        for (size_t i = 0; i < n; i += 4) {
+            const __mmask8 k = n - i >= 4 ? 0xFF : static_cast<__mmask8>((1u << (2 * (n - i))) - 1);
+            __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(k, a + 2 * i), _mm512_maskz_loadu_pd(k, b + 2 * i));
+            _mm512_mask_storeu_pd(out + 2 * i, k, d);
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void ConjC64Avx512(const double* a, double* out, size_t n) {
+        const __m512i sign = _mm512_set_epi64(INT64_MIN, 0, INT64_MIN, 0, INT64_MIN, 0, INT64_MIN, 0);
+        for (size_t i = 0; i < n; i += 4) {
+            const __mmask8 k = n - i >= 4 ? 0xFF : static_cast<__mmask8>((1u << (2 * (n - i))) - 1);
+            __m512i x = _mm512_castpd_si512(_mm512_maskz_loadu_pd(k, a + 2 * i));
+            _mm512_mask_storeu_pd(out + 2 * i, k, _mm512_castsi512_pd(_mm512_xor_si512(x, sign)));
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    void ExpF32Avx2(const float* a, float* out, size_t n, bool fast) { MathKernel<float, 8, MathFn::Exp>(a, out, n, fast); }
+    __attribute__((target("avx2,fma")))
+    void ExpF64Avx2(const double* a, double* out, size_t n, bool fast) { MathKernel<double, 4, MathFn::Exp>(a, out, n, fast); }
+    __attribute__((target("avx2,fma")))
+    void Log10F32Avx2(const float* a, float* out, size_t n, bool fast) { MathKernel<float, 8, MathFn::Log10>(a, out, n, fast); }
+    __attribute__((target("avx2,fma")))
+    void Log10F64Avx2(const double* a, double* out, size_t n, bool fast) { MathKernel<double, 4, MathFn::Log10>(a, out, n, fast); }
+
+    __attribute__((target("avx512f")))
+    void ExpF32Avx512(const float* a, float* out, size_t n, bool fast) { MathKernel<float, 16, MathFn::Exp>(a, out, n, fast); }
+    __attribute__((target("avx512f")))
+    void ExpF64Avx512(const double* a, double* out, size_t n, bool fast) { MathKernel<double, 8, MathFn::Exp>(a, out, n, fast); }
+    __attribute__((target("avx512f")))
+    void Log10F32Avx512(const float* a, float* out, size_t n, bool fast) { MathKernel<float, 16, MathFn::Log10>(a, out, n, fast); }
+    __attribute__((target("avx512f")))
+    void Log10F64Avx512(const double* a, double* out, size_t n, bool fast) { MathKernel<double, 8, MathFn::Log10>(a, out, n, fast); }
+
+    // 6 x 2 and 12 x 2 vector blocks: 12 and 24 accumulators of the 16 and 32 vector registers.
+    __attribute__((target("avx2,fma")))
+    void GemmF32Avx2(size_t k, const float* a, const float* b, float* c, size_t ldc, bool acc) { GemmBlock<float, 8, 6, 2>(k, a, b, c, ldc, acc); }
+    __attribute__((target("avx2,fma")))
+    void GemmF64Avx2(size_t k, const double* a, const double* b, double* c, size_t ldc, bool acc) { GemmBlock<double, 4, 6, 2>(k, a, b, c, ldc, acc); }
+    __attribute__((target("avx2,fma")))
+    void GemmI32Avx2(size_t k, const int32_t* a, const int32_t* b, int32_t* c, size_t ldc, bool acc) { GemmBlock<int32_t, 8, 6, 2>(k, a, b, c, ldc, acc); }
+
+    __attribute__((target("avx512f")))
+    void GemmF32Avx512(size_t k, const float* a, const float* b, float* c, size_t ldc, bool acc) { GemmBlock<float, 16, 12, 2>(k, a, b, c, ldc, acc); }
+    __attribute__((target("avx512f")))
+    void GemmF64Avx512(size_t k, const double* a, const double* b, double* c, size_t ldc, bool acc) { GemmBlock<double, 8, 12, 2>(k, a, b, c, ldc, acc); }
+    __attribute__((target("avx512f")))
+    void GemmI32Avx512(size_t k, const int32_t* a, const int32_t* b, int32_t* c, size_t ldc, bool acc) { GemmBlock<int32_t, 16, 12, 2>(k, a, b, c, ldc, acc); }
+
+#endif  // TAI_SIMD_X86
+
+    // TAI_SIMD=scalar|sse3|avx2|avx512 in the environment caps the choice, for testing.
+    int Level() {
+        int level = 0;
+#ifdef TAI_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse3")) level = 1;
+        if (level == 1 && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) level = 2;
+        if (level == 2 && __builtin_cpu_supports("avx512f")) level = 3;
+#endif
+        const char* cap = getenv("TAI_SIMD");
+        if (cap) {
+            const char* names[] = {"scalar", "sse3", "avx2", "avx512"};
+            for (int i = 0; i < 4; ++i) {
+                if (strcmp(cap, names[i]) == 0) level = std::min(level, i);
+            }
+        }
+        return level;
+    }
+
+    SimdKernels Select() {
+        const int level = Level();
+        SimdKernels k{"scalar",
+                      MulScalar<float>, MuliScalar<float>, SubScalar<float>, ConjScalar<float>, AbsScalar<float>,
+                      MulScalar<double>, MuliScalar<double>, SubScalar<double>, ConjScalar<double>, AbsScalar<double>,
+                      FftStageI16Scalar,
+                      ExpF32Generic, ExpF64Generic, Log10F32Generic, Log10F64Generic,
+                      {GemmF32Generic, 4, 8}, {GemmF64Generic, 4, 4}, {GemmI32Generic, 4, 8}};
+#ifdef TAI_SIMD_X86
+        if (level >= 1) {
+            k = {"sse3",
+                 MulC32Sse, MuliC32Sse, SubC32Sse, ConjC32Sse, AbsC32Sse,
+                 MulC64Sse, MuliC64Sse, SubC64Sse, ConjC64Sse, AbsC64Sse,
+                 FftStageI16Scalar,
+                 ExpF32Generic, ExpF64Generic, Log10F32Generic, Log10F64Generic,
+                 {GemmF32Generic, 4, 8}, {GemmF64Generic, 4, 4}, {GemmI32Generic, 4, 8}};
+        }
+        if (level >= 2) {
+            k = {"avx2",
+                 MulC32Avx2, MuliC32Avx2, SubC32Avx2, ConjC32Avx2, AbsC32Avx2,
+                 MulC64Avx2, MuliC64Avx2, SubC64Avx2, ConjC64Avx2, AbsC64Sse,
+                 FftStageI16Avx2,
+                 ExpF32Avx2, ExpF64Avx2, Log10F32Avx2, Log10F64Avx2,
+                 {GemmF32Avx2, 6, 16}, {GemmF64Avx2, 6, 8}, {GemmI32Avx2, 6, 16}};
+        }
+        if (level >= 3) {
+            // |z| keeps the AVX2 and SSE3 versions, they are bound by the double conversions.
+            k.isa = "avx512";
+            k.mul_c32 = MulC32Avx512;
+            k.muli_c32 = MuliC32Avx512;
+            k.sub_c32 = SubC32Avx512;
+            k.conj_c32 = ConjC32Avx512;
+            k.mul_c64 = MulC64Avx512;
+            k.muli_c64 = MuliC64Avx512;
+            k.sub_c64 = SubC64Avx512;
+            k.conj_c64 = ConjC64Avx512;
+            k.exp_f32 = ExpF32Avx512;
+            k.exp_f64 = ExpF64Avx512;
+            k.log10_f32 = Log10F32Avx512;
+            k.log10_f64 = Log10F64Avx512;
+            k.gemm_f32 = {GemmF32Avx512, 12, 32};
+            k.gemm_f64 = {GemmF64Avx512, 12, 16};
+            k.gemm_i32 = {GemmI32Avx512, 12, 32};
+        }
+#endif
+        return k;
+    }
+
+}  // namespace
+
+const SimdKernels& tai::Simd() {
+    static const SimdKernels kernels = Select();
+    return kernels;
+}
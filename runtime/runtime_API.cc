@@ -38,6 +38,25 @@ void InitFPGA() {
     fpga_open();
 }
 
+void InitFPGA(const size_t* fft_lens, size_t count) {
+    fpga_open();
+    for (size_t i = 0; i < count; ++i) {
+        fpga_fft_prewarm(fft_lens[i]);
+    }
+}
+
+double rtFftProfile(size_t* len, size_t* nsec) {
+    unsigned long long l = 0, ns = 0;
+    double gflops = fpga_fft_profile(&l, &ns);
+    if (len) *len = l;
+    if (nsec) *nsec = ns;
+    return gflops;
+}
+
+size_t rtFftPlanCount() {
+    return fpga_fft_plan_count();
+}
+
 unsigned int rtLaunchKernel(unsigned int op, size_t argsize, void** args) {
     while (op) {
         fpga_wait_irq(op, 2, args);
@@ -1,12 +1,35 @@
 #ifndef TAI_SIM_RUNTIME_API
 #define TAI_SIM_RUNTIME_API
 
+#include <stddef.h>
+
 #define _API_CALL
 
 typedef void* HANDLE;
 
 void InitFPGA();
 
+// Same as InitFPGA(), and also builds the FFT/IFFT plans for the given lengths
+// so the first launch of each length does not pay for twiddle generation.
+void InitFPGA(const size_t* fft_lens, size_t count);
+
+// Device bytes for the state of a streaming FIR (irq 11 FirInit, irq 12 FirStream)
+// with the given number of taps: a header, the taps and a delay line of taps - 1 samples.
+#define FIR_STATE_SIZE(taps) (8 + 4 * ((taps) ? 2 * (size_t)(taps) - 1 : 0))
+
+// Device bytes for the state of a polyphase channelizer (irq 24 ChanInit, irq 25 Chan):
+// a header, the taps and room for taps - 1 + channels - 1 complex samples.
+#define CHAN_STATE_SIZE(channels, taps) \
+  (16 + 4 * (size_t)(taps) + 8 * ((taps) && (channels) ? (size_t)(taps) + (channels) - 2 : 0))
+
+// GFLOP/s of the last FFT/IFFT launch (irq 1, irq 2), with its length and time in ns if
+// the pointers are not null.
+double rtFftProfile(size_t* len, size_t* nsec);
+
+// Number of FFT plans built so far. Plans are cached per length, direction and kind, so
+// repeated launches of one length and lengths passed to InitFPGA add none.
+size_t rtFftPlanCount();
+
 unsigned int rtLaunchKernel(unsigned op, size_t argsize, void** args);
 
 void* rtMalloc(size_t size);
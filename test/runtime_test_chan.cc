@@ -0,0 +1,73 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 1000
+#define CHANNELS 8
+#define TAPS 60
+
+int main() {
+  InitFPGA();
+
+  // windowed-sinc prototype with a cutoff of half a channel
+  float taps[TAPS];
+  for (int j = 0; j < TAPS; ++j) {
+    double x = j - (TAPS - 1) / 2.0;
+    double sinc = x == 0 ? 1.0 : sin(M_PI * x / CHANNELS) / (M_PI * x / CHANNELS);
+    taps[j] = (float)(sinc * (0.54 - 0.46 * cos(2 * M_PI * j / (TAPS - 1))) / CHANNELS);
+  }
+
+  float _Complex input[LEN], output[LEN];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = cexpf(2.0f * M_PI * I * 0.26f * i) + 0.5f * cexpf(-2.0f * M_PI * I * 0.1f * i);
+  }
+
+  void *taps_addr = rtMalloc(sizeof(taps));
+  void *state_addr = rtMalloc(CHAN_STATE_SIZE(CHANNELS, TAPS));
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+
+  rtMemcpyH2D(taps, taps_addr, sizeof(taps));
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  void *args1[] = {state_addr, taps_addr, (void *)TAPS, (void *)CHANNELS};
+  rtLaunchKernel(24, 4 * sizeof(void *), args1);
+
+  // feed the stream in blocks that do not line up with the frames
+  static const int blocks[] = {333, 5, 250, 412};
+  int consumed = 0, frames = 0;
+  for (int b = 0; b < 4; ++b) {
+    void *args2[] = {(char *)input_addr + sizeof(float _Complex) * consumed, state_addr,
+                     (char *)output_addr + sizeof(float _Complex) * CHANNELS * frames, (void *)(long)blocks[b]};
+    rtLaunchKernel(25, 4 * sizeof(void *), args2);
+    consumed += blocks[b];
+    frames = consumed / CHANNELS;
+  }
+
+  rtMemcpyD2H(output_addr, output, sizeof(float _Complex) * CHANNELS * frames);
+
+  rtFree(taps_addr);
+  rtFree(state_addr);
+  rtFree(input_addr);
+  rtFree(output_addr);
+
+  float sum = 0.0;
+  for (int f = 0; f < frames; ++f) {
+    for (int k = 0; k < CHANNELS; ++k) {
+      float _Complex expect = 0;
+      for (int j = 0; j < TAPS; ++j) {
+        int n = f * CHANNELS + CHANNELS - 1 - j;
+        if (n >= 0) expect += taps[j] * input[n] * cexpf(2.0f * M_PI * I * k * j / CHANNELS);
+      }
+      float tem = cabsf(output[f * CHANNELS + k] - expect);
+      sum += tem * tem;
+    }
+  }
+  sum /= frames * CHANNELS;
+  printf("CHAN frames = %d, MSE = %e\n", frames, sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,51 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 2000
+#define POINTS 200
+
+int main() {
+  InitFPGA();
+
+  float _Complex input[LEN], output[POINTS];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = cexpf(2.0f * M_PI * I * 0.10512f * i) + 0.2f * cosf(0.3f * i);
+  }
+
+  // zoom on [0.1, 0.12) cycles per sample with a spacing of 1e-4, in 2^-64 cycles
+  const double f0 = 0.1, df = 1e-4;
+  unsigned long long start = (unsigned long long)ldexp(f0, 64);
+  unsigned long long step = (unsigned long long)ldexp(df, 64);
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * POINTS);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  void *args[] = {input_addr, output_addr, (void *)LEN, (void *)start, (void *)step, (void *)POINTS};
+  rtLaunchKernel(23, 6 * sizeof(void *), args);
+
+  rtMemcpyD2H(output_addr, output, sizeof(float _Complex) * POINTS);
+
+  rtFree(input_addr);
+  rtFree(output_addr);
+
+  float sum = 0.0;
+  for (int k = 0; k < POINTS; ++k) {
+    double f = ldexp((double)start, -64) + k * ldexp((double)step, -64);
+    double _Complex expect = 0;
+    for (int i = 0; i < LEN; ++i) {
+      expect += input[i] * cexp(-2.0 * M_PI * I * fmod(f * i, 1.0));
+    }
+    float tem = cabs(output[k] - expect);
+    sum += tem * tem;
+  }
+  sum /= POINTS;
+  printf("CZT MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
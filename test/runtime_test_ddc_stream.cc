@@ -0,0 +1,48 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define BLOCK 100
+#define BLOCKS 4
+#define LEN (BLOCK * BLOCKS)
+// 0.0123 cycles per sample in units of 2^-32
+#define STEP 52828500
+
+int main() {
+  InitFPGA();
+
+  float input[LEN];
+  float _Complex output[LEN];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = 1.0f + 0.5f * sinf(0.01f * i);
+  }
+
+  void *input_addr = rtMalloc(sizeof(float) * BLOCK);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * BLOCK);
+
+  // the oscillator phase continues from one block to the next
+  for (int b = 0; b < BLOCKS; ++b) {
+    rtMemcpyH2D(input + b * BLOCK, input_addr, sizeof(float) * BLOCK);
+    void *args[] = {input_addr, output_addr, (void *)BLOCK, (void *)STEP, (void *)(b == 0)};
+    rtLaunchKernel(14, 5 * sizeof(void *), args);
+    rtMemcpyD2H(output_addr, output + b * BLOCK, sizeof(float _Complex) * BLOCK);
+  }
+
+  rtFree(input_addr);
+  rtFree(output_addr);
+
+  float sum = 0.0;
+  for (int i = 0; i < LEN; ++i) {
+    double cycles = fmod((double)i * STEP / 4294967296.0, 1.0);
+    float _Complex expect = input[i] * cexpf(-2 * M_PI * I * cycles);
+    float tem = cabsf(output[i] - expect);
+    sum += tem * tem;
+  }
+  sum /= LEN;
+  printf("MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
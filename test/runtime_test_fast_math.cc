@@ -0,0 +1,52 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 10000
+
+int main() {
+  InitFPGA();
+
+  static float input[LEN], exp_output[LEN];
+  static double log_output[LEN];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = -20.0f + 40.0f * i / LEN + 0.001f;
+  }
+
+  void *input_addr = rtMalloc(sizeof(float) * LEN);
+  void *exp_addr = rtMalloc(sizeof(float) * LEN);
+  void *log_addr = rtMalloc(sizeof(double) * LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float) * LEN);
+
+  // MATH_MODE 0 libm, 1 polynomial within 2 ULP, 2 fast polynomial
+  for (long mode = 0; mode < 3; ++mode) {
+    void *args1[] = {input_addr, exp_addr, (void *)LEN, (void *)mode};
+    rtLaunchKernel(27, 4 * sizeof(void *), args1);
+
+    // log10 of the exp outputs, all positive
+    void *args2[] = {exp_addr, log_addr, (void *)LEN, (void *)mode};
+    rtLaunchKernel(28, 4 * sizeof(void *), args2);
+
+    rtMemcpyD2H(exp_addr, exp_output, sizeof(float) * LEN);
+    rtMemcpyD2H(log_addr, log_output, sizeof(double) * LEN);
+
+    double exp_err = 0.0, log_err = 0.0;
+    for (int i = 0; i < LEN; ++i) {
+      double tem = fabs(exp_output[i] - exp((double)input[i])) / exp((double)input[i]);
+      if (tem > exp_err) exp_err = tem;
+      tem = fabs(log_output[i] - log10((double)exp_output[i]));
+      if (tem > log_err) log_err = tem;
+    }
+    printf("MATH_MODE %ld: VEXP.F32 max rel err = %e, VLOG10.F32 max abs err = %e\n", mode, exp_err, log_err);
+
+    // EXPECT_LT(exp_err, 0.0001);
+    // EXPECT_LT(log_err, 0.0001);
+  }
+
+  rtFree(input_addr);
+  rtFree(exp_addr);
+  rtFree(log_addr);
+}
@@ -0,0 +1,66 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define X_SIZE 24
+#define Y_SIZE 20
+#define LEN (X_SIZE * Y_SIZE)
+
+int main() {
+  InitFPGA();
+
+  float _Complex input[LEN], spectrum[LEN], output[LEN];
+  for (int i = 0; i < X_SIZE; ++i) {
+    for (int j = 0; j < Y_SIZE; ++j) {
+      input[i * Y_SIZE + j] = cosf(0.4f * i + 0.1f * j * j) + 0.2f * (i - j) * I;
+    }
+  }
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *fft_output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *ifft_output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  // fft2d
+  void *args1[] = {input_addr, fft_output_addr, (void *)X_SIZE, (void *)Y_SIZE};
+  rtLaunchKernel(15, 4 * sizeof(void *), args1);
+
+  // ifft2d
+  void *args2[] = {fft_output_addr, ifft_output_addr, (void *)X_SIZE, (void *)Y_SIZE};
+  rtLaunchKernel(16, 4 * sizeof(void *), args2);
+
+  rtMemcpyD2H(fft_output_addr, spectrum, sizeof(float _Complex) * LEN);
+  rtMemcpyD2H(ifft_output_addr, output, sizeof(float _Complex) * LEN);
+
+  rtFree(input_addr);
+  rtFree(fft_output_addr);
+  rtFree(ifft_output_addr);
+
+  float fft_sum = 0.0, ifft_sum = 0.0;
+  for (int u = 0; u < X_SIZE; ++u) {
+    for (int v = 0; v < Y_SIZE; ++v) {
+      float _Complex expect = 0;
+      for (int i = 0; i < X_SIZE; ++i) {
+        for (int j = 0; j < Y_SIZE; ++j) {
+          expect += input[i * Y_SIZE + j] *
+                    cexpf(-2.0f * M_PI * I * ((float)(u * i % X_SIZE) / X_SIZE + (float)(v * j % Y_SIZE) / Y_SIZE));
+        }
+      }
+      float tem = cabsf(spectrum[u * Y_SIZE + v] - expect);
+      fft_sum += tem * tem;
+      tem = cabsf(output[u * Y_SIZE + v] - input[u * Y_SIZE + v]);
+      ifft_sum += tem * tem;
+    }
+  }
+  fft_sum /= LEN;
+  ifft_sum /= LEN;
+  printf("FFT2D MSE = %e\n", fft_sum);
+  printf("IFFT2D MSE = %e\n", ifft_sum);
+
+  // EXPECT_LT(fft_sum, 0.0001);
+  // EXPECT_LT(ifft_sum, 0.0001);
+}
@@ -0,0 +1,63 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 12
+#define ROWS 6
+#define STRIDE 16
+
+int main() {
+  InitFPGA();
+
+  float _Complex input[ROWS * STRIDE], spectrum[ROWS * STRIDE], output[ROWS * STRIDE];
+  for (int r = 0; r < ROWS; ++r) {
+    for (int i = 0; i < STRIDE; ++i) {
+      input[r * STRIDE + i] = (r + 1) * cosf(0.3f * i) + 0.5f * i * I;
+    }
+  }
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * ROWS * STRIDE);
+  void *fft_output_addr = rtMalloc(sizeof(float _Complex) * ROWS * STRIDE);
+  void *ifft_output_addr = rtMalloc(sizeof(float _Complex) * ROWS * STRIDE);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * ROWS * STRIDE);
+
+  // fft of every row
+  void *args1[] = {input_addr, fft_output_addr, (void *)LEN, (void *)ROWS, (void *)STRIDE};
+  rtLaunchKernel(7, 5 * sizeof(void *), args1);
+
+  // ifft of every row
+  void *args2[] = {fft_output_addr, ifft_output_addr, (void *)LEN, (void *)ROWS, (void *)STRIDE};
+  rtLaunchKernel(8, 5 * sizeof(void *), args2);
+
+  rtMemcpyD2H(fft_output_addr, spectrum, sizeof(float _Complex) * ROWS * STRIDE);
+  rtMemcpyD2H(ifft_output_addr, output, sizeof(float _Complex) * ROWS * STRIDE);
+
+  rtFree(input_addr);
+  rtFree(fft_output_addr);
+  rtFree(ifft_output_addr);
+
+  float fft_sum = 0.0, ifft_sum = 0.0;
+  for (int r = 0; r < ROWS; ++r) {
+    for (int k = 0; k < LEN; ++k) {
+      float _Complex expect = 0;
+      for (int i = 0; i < LEN; ++i) {
+        expect += input[r * STRIDE + i] * cexpf(-2.0f * M_PI * I * k * i / LEN);
+      }
+      float tem = cabsf(spectrum[r * STRIDE + k] - expect);
+      fft_sum += tem * tem;
+      tem = cabsf(output[r * STRIDE + k] - input[r * STRIDE + k]);
+      ifft_sum += tem * tem;
+    }
+  }
+  fft_sum /= ROWS * LEN;
+  ifft_sum /= ROWS * LEN;
+  printf("FFT MSE = %e\n", fft_sum);
+  printf("IFFT MSE = %e\n", ifft_sum);
+
+  // EXPECT_LT(fft_sum, 0.0001);
+  // EXPECT_LT(ifft_sum, 0.0001);
+}
@@ -0,0 +1,59 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 256
+#define STAGES 8
+
+int main() {
+  InitFPGA();
+
+  int16_t input[2 * LEN], output[2 * LEN];
+  int32_t exps[STAGES];
+  for (int i = 0; i < LEN; ++i) {
+    input[2 * i] = (int16_t)(12000 * cosf(0.3f * i) + 3000 * sinf(0.05f * i * i));
+    input[2 * i + 1] = (int16_t)(8000 * sinf(0.7f * i));
+  }
+
+  void *input_addr = rtMalloc(sizeof(int16_t) * 2 * LEN);
+  void *output_addr = rtMalloc(sizeof(int16_t) * 2 * LEN);
+  void *exps_addr = rtMalloc(sizeof(int32_t) * STAGES);
+
+  rtMemcpyH2D(input, input_addr, sizeof(int16_t) * 2 * LEN);
+
+  // fft.i16
+  void *args[] = {input_addr, output_addr, exps_addr, (void *)LEN};
+  rtLaunchKernel(17, 4 * sizeof(void *), args);
+
+  rtMemcpyD2H(output_addr, output, sizeof(int16_t) * 2 * LEN);
+  rtMemcpyD2H(exps_addr, exps, sizeof(int32_t) * STAGES);
+
+  rtFree(input_addr);
+  rtFree(output_addr);
+  rtFree(exps_addr);
+
+  int exponent = 0;
+  for (int s = 0; s < STAGES; ++s) {
+    printf("stage %d shift %d\n", s, exps[s]);
+    exponent += exps[s];
+  }
+
+  float noise = 0.0, power = 0.0;
+  for (int k = 0; k < LEN; ++k) {
+    float _Complex expect = 0;
+    for (int i = 0; i < LEN; ++i) {
+      expect += (input[2 * i] + input[2 * i + 1] * I) * cexpf(-2.0f * M_PI * I * (k * i % LEN) / LEN);
+    }
+    float _Complex real = ldexpf(output[2 * k], exponent) + ldexpf(output[2 * k + 1], exponent) * I;
+    float tem = cabsf(real - expect);
+    noise += tem * tem;
+    power += cabsf(expect) * cabsf(expect);
+  }
+  printf("SNR = %f dB\n", 10 * log10f(power / noise));
+
+  // EXPECT_GT(10 * log10f(power / noise), 50);
+}
@@ -0,0 +1,71 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN (1 << 22)
+
+int main() {
+  InitFPGA();
+
+  // two tones, so the expected spectrum is known without a reference DFT
+  const int f1 = 12345, f2 = 3000001;
+  float _Complex *input = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  float _Complex *spectrum = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  float _Complex *output = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  for (int i = 0; i < LEN; ++i) {
+    double a1 = 2 * M_PI * (double)f1 * i / LEN, a2 = 2 * M_PI * (double)((long)f2 * i % LEN) / LEN;
+    input[i] = (float)(cos(a1) + 0.5 * cos(a2)) + (float)(sin(a1) + 0.5 * sin(a2)) * I;
+  }
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *fft_output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *ifft_output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  size_t len = 0, nsec = 0;
+  double gflops;
+
+  // fft
+  void *args1[] = {input_addr, fft_output_addr, (void *)LEN};
+  rtLaunchKernel(1, 3 * sizeof(void *), args1);
+  gflops = rtFftProfile(&len, &nsec);
+  printf("FFT %zu points: %.3f ms, %.2f GFLOP/s\n", len, nsec / 1e6, gflops);
+
+  // ifft
+  void *args2[] = {fft_output_addr, ifft_output_addr, (void *)LEN};
+  rtLaunchKernel(2, 3 * sizeof(void *), args2);
+  gflops = rtFftProfile(&len, &nsec);
+  printf("IFFT %zu points: %.3f ms, %.2f GFLOP/s\n", len, nsec / 1e6, gflops);
+
+  rtMemcpyD2H(fft_output_addr, spectrum, sizeof(float _Complex) * LEN);
+  rtMemcpyD2H(ifft_output_addr, output, sizeof(float _Complex) * LEN);
+
+  rtFree(input_addr);
+  rtFree(fft_output_addr);
+  rtFree(ifft_output_addr);
+
+  float fft_sum = 0.0, ifft_sum = 0.0;
+  for (int k = 0; k < LEN; ++k) {
+    float _Complex expect = k == f1 ? 1.0f : k == f2 ? 0.5f : 0.0f;
+    float tem = cabsf(spectrum[k] / LEN - expect);
+    fft_sum += tem * tem;
+    tem = cabsf(output[k] - input[k]);
+    ifft_sum += tem * tem;
+  }
+  fft_sum /= LEN;
+  ifft_sum /= LEN;
+  printf("FFT MSE = %e\n", fft_sum);
+  printf("IFFT MSE = %e\n", ifft_sum);
+
+  free(input);
+  free(spectrum);
+  free(output);
+
+  // EXPECT_LT(fft_sum, 0.0001);
+  // EXPECT_LT(ifft_sum, 0.0001);
+}
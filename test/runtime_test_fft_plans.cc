@@ -0,0 +1,57 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 4096
+#define OTHER 1000
+
+int main() {
+  size_t empty = rtFftPlanCount();
+  const size_t lens[] = {LEN, OTHER};
+  InitFPGA(lens, 2);
+  // forward and inverse plans of both lengths
+  size_t prewarmed = rtFftPlanCount();
+
+  float _Complex *input = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = sinf(0.01f * i) + cosf(0.003f * i) * I;
+  }
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  // prewarmed lengths, several times each: nothing new is built
+  for (int rep = 0; rep < 3; ++rep) {
+    void *args1[] = {input_addr, output_addr, (void *)LEN};
+    rtLaunchKernel(1, 3 * sizeof(void *), args1);
+    rtLaunchKernel(2, 3 * sizeof(void *), args1);
+    void *args2[] = {input_addr, output_addr, (void *)OTHER};
+    rtLaunchKernel(1, 3 * sizeof(void *), args2);
+  }
+  size_t reused = rtFftPlanCount();
+
+  // a new length is built on its first launch and reused afterwards
+  void *args3[] = {input_addr, output_addr, (void *)(LEN / 2)};
+  rtLaunchKernel(1, 3 * sizeof(void *), args3);
+  size_t first = rtFftPlanCount();
+  rtLaunchKernel(1, 3 * sizeof(void *), args3);
+  rtLaunchKernel(1, 3 * sizeof(void *), args3);
+  size_t again = rtFftPlanCount();
+
+  printf("FFT plans: %zu before InitFPGA, %zu after, %zu after repeated launches, %zu after a new length, %zu after repeating it\n",
+         empty, prewarmed, reused, first, again);
+
+  rtFree(input_addr);
+  rtFree(output_addr);
+  free(input);
+
+  // EXPECT_EQ(empty, 0);
+  // EXPECT_EQ(prewarmed, 4);
+  // EXPECT_EQ(reused, prewarmed);
+  // EXPECT_EQ(first, prewarmed + 1);
+  // EXPECT_EQ(again, first);
+}
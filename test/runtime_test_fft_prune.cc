@@ -0,0 +1,54 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 4096
+#define MAX_BINS 512
+
+int main() {
+  InitFPGA();
+
+  float _Complex input[LEN], output[MAX_BINS];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = cosf(0.01f * i + 0.0001f * i * i) + 0.3f * sinf(0.5f * i) * I;
+  }
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * MAX_BINS);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  // a band of bins, every 8th bin, and two isolated bins
+  static const int cases[3][3] = {{100, 1, 64}, {3, 8, MAX_BINS}, {4000, 1, 2}};
+  float sum = 0.0;
+  int total = 0;
+  for (int c = 0; c < 3; ++c) {
+    const int first = cases[c][0], stride = cases[c][1], count = cases[c][2];
+    void *args[] = {input_addr, output_addr, (void *)LEN, (void *)(long)first, (void *)(long)stride,
+                    (void *)(long)count};
+    rtLaunchKernel(22, 6 * sizeof(void *), args);
+    rtMemcpyD2H(output_addr, output, sizeof(float _Complex) * count);
+
+    for (int j = 0; j < count; ++j) {
+      int k = (first + j * stride) % LEN;
+      float _Complex expect = 0;
+      for (int i = 0; i < LEN; ++i) {
+        expect += input[i] * cexpf(-2.0f * M_PI * I * (float)((long)k * i % LEN) / LEN);
+      }
+      float tem = cabsf(output[j] - expect);
+      sum += tem * tem;
+    }
+    total += count;
+  }
+
+  rtFree(input_addr);
+  rtFree(output_addr);
+
+  sum /= total;
+  printf("FFT.PRUNE MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,54 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 96
+
+int main() {
+  InitFPGA();
+
+  float _Complex input[LEN], output[LEN];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = cosf(0.7f * i) + 0.25f * sinf(0.2f * i) * I;
+  }
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+
+  // Hann, Hamming, Blackman and Blackman-Harris, each launched twice to reuse the cached table
+  static const double coef[4][4] = {
+      {0.5, 0.5, 0, 0}, {0.54, 0.46, 0, 0}, {0.42, 0.5, 0.08, 0}, {0.35875, 0.48829, 0.14128, 0.01168}};
+  float sum = 0.0;
+  for (int w = 1; w <= 4; ++w) {
+    for (int rep = 0; rep < 2; ++rep) {
+      void *args[] = {input_addr, output_addr, (void *)LEN, (void *)(long)w};
+      rtLaunchKernel(19, 4 * sizeof(void *), args);
+      rtMemcpyD2H(output_addr, output, sizeof(float _Complex) * LEN);
+
+      for (int k = 0; k < LEN; ++k) {
+        float _Complex expect = 0;
+        for (int i = 0; i < LEN; ++i) {
+          const double *a = coef[w - 1];
+          double win = a[0] - a[1] * cos(2 * M_PI * i / LEN) + a[2] * cos(4 * M_PI * i / LEN) -
+                       a[3] * cos(6 * M_PI * i / LEN);
+          expect += input[i] * (float)win * cexpf(-2.0f * M_PI * I * k * i / LEN);
+        }
+        float tem = cabsf(output[k] - expect);
+        sum += tem * tem;
+      }
+    }
+  }
+
+  rtFree(input_addr);
+  rtFree(output_addr);
+
+  sum /= 8 * LEN;
+  printf("FFT.WIN MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,61 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define ULEN 200
+#define VLEN 24
+#define X_SIZE 3
+#define LEN (ULEN + VLEN - 1)
+#define OUT_LEN ((LEN - 1) / (X_SIZE + 1) + 1)
+
+int main() {
+  InitFPGA();
+
+  float input[ULEN], taps[VLEN], output[OUT_LEN], expect[OUT_LEN];
+  for (int i = 0; i < ULEN; ++i) {
+    input[i] = sinf(0.05f * i) + 0.3f * cosf(1.3f * i);
+  }
+  for (int j = 0; j < VLEN; ++j) {
+    taps[j] = 0.5f - fabsf(j - VLEN / 2.0f) / VLEN;
+  }
+
+  void *input_addr = rtMalloc(sizeof(float) * ULEN);
+  void *taps_addr = rtMalloc(sizeof(float) * VLEN);
+  void *fir_output_addr = rtMalloc(sizeof(float) * LEN);
+  void *extr_output_addr = rtMalloc(sizeof(float) * OUT_LEN);
+  void *decim_output_addr = rtMalloc(sizeof(float) * OUT_LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float) * ULEN);
+  rtMemcpyH2D(taps, taps_addr, sizeof(float) * VLEN);
+
+  // fir + extr
+  void *args1[] = {input_addr, taps_addr, fir_output_addr, (void *)ULEN, (void *)VLEN};
+  rtLaunchKernel(5, 5 * sizeof(void *), args1);
+  void *args2[] = {fir_output_addr, extr_output_addr, (void *)LEN, (void *)X_SIZE};
+  rtLaunchKernel(3, 4 * sizeof(void *), args2);
+
+  // fused
+  void *args3[] = {input_addr, taps_addr, decim_output_addr, (void *)ULEN, (void *)VLEN, (void *)X_SIZE};
+  rtLaunchKernel(13, 6 * sizeof(void *), args3);
+
+  rtMemcpyD2H(extr_output_addr, expect, sizeof(float) * OUT_LEN);
+  rtMemcpyD2H(decim_output_addr, output, sizeof(float) * OUT_LEN);
+
+  rtFree(input_addr);
+  rtFree(taps_addr);
+  rtFree(fir_output_addr);
+  rtFree(extr_output_addr);
+  rtFree(decim_output_addr);
+
+  float sum = 0.0;
+  for (int i = 0; i < OUT_LEN; ++i) {
+    float tem = output[i] - expect[i];
+    sum += tem * tem;
+  }
+  sum /= OUT_LEN;
+  printf("MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,60 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define TAPS 9
+#define BLOCK 16
+#define BLOCKS 5
+#define LEN (BLOCK * BLOCKS)
+
+int main() {
+  InitFPGA();
+
+  float taps[TAPS], input[LEN], output[LEN];
+  for (int j = 0; j < TAPS; ++j) {
+    taps[j] = 1.0f / (j + 1);
+  }
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = sinf(0.2f * i) + 0.1f * (i % 7);
+  }
+
+  void *state_addr = rtMalloc(FIR_STATE_SIZE(TAPS));
+  void *taps_addr = rtMalloc(sizeof(float) * TAPS);
+  void *input_addr = rtMalloc(sizeof(float) * BLOCK);
+  void *output_addr = rtMalloc(sizeof(float) * BLOCK);
+
+  rtMemcpyH2D(taps, taps_addr, sizeof(float) * TAPS);
+
+  // load taps, clear the delay line
+  void *args1[] = {state_addr, taps_addr, (void *)TAPS};
+  rtLaunchKernel(11, 3 * sizeof(void *), args1);
+
+  // one block per launch, history is carried in the state
+  for (int b = 0; b < BLOCKS; ++b) {
+    rtMemcpyH2D(input + b * BLOCK, input_addr, sizeof(float) * BLOCK);
+    void *args2[] = {input_addr, state_addr, output_addr, (void *)BLOCK};
+    rtLaunchKernel(12, 4 * sizeof(void *), args2);
+    rtMemcpyD2H(output_addr, output + b * BLOCK, sizeof(float) * BLOCK);
+  }
+
+  rtFree(state_addr);
+  rtFree(taps_addr);
+  rtFree(input_addr);
+  rtFree(output_addr);
+
+  float sum = 0.0;
+  for (int i = 0; i < LEN; ++i) {
+    float expect = 0;
+    for (int j = 0; j < TAPS && j <= i; ++j) {
+      expect += taps[j] * input[i - j];
+    }
+    float tem = output[i] - expect;
+    sum += tem * tem;
+  }
+  sum /= LEN;
+  printf("MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,46 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 10000
+
+int main() {
+  InitFPGA();
+
+  static float _Complex a[LEN], c[LEN];
+  static double output[LEN];
+  for (int i = 0; i < LEN; ++i) {
+    a[i] = (1.0f + 0.5f * cosf(0.01f * i)) + 0.3f * sinf(0.02f * i) * I;
+    c[i] = 0.7f * cosf(0.003f * i) + (0.2f + 0.1f * i / LEN) * I;
+  }
+
+  void *a_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *c_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *output_addr = rtMalloc(sizeof(double) * LEN);
+
+  rtMemcpyH2D(a, a_addr, sizeof(float _Complex) * LEN);
+  rtMemcpyH2D(c, c_addr, sizeof(float _Complex) * LEN);
+
+  // log10 |a * c| as one fused VMUL.C32 -> VABS.C32 -> VLOG10.F32 chain
+  void *args[] = {a_addr, c_addr, output_addr, (void *)LEN};
+  rtLaunchKernel(26, 4 * sizeof(void *), args);
+
+  rtMemcpyD2H(output_addr, output, sizeof(double) * LEN);
+
+  rtFree(a_addr);
+  rtFree(c_addr);
+  rtFree(output_addr);
+
+  double sum = 0.0;
+  for (int i = 0; i < LEN; ++i) {
+    double tem = output[i] - log10(cabs(a[i] * c[i]));
+    sum += tem * tem;
+  }
+  sum /= LEN;
+  printf("FUSED MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
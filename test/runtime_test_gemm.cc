@@ -0,0 +1,63 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+// not a multiple of any register block, and more than one k block
+#define M 333
+#define K 1517
+#define N 271
+
+int main() {
+  InitFPGA();
+
+  float *a = (float *)malloc(sizeof(float) * M * K);
+  float *b = (float *)malloc(sizeof(float) * K * N);
+  float *c = (float *)malloc(sizeof(float) * M * N);
+  double *ref = (double *)calloc(M * N, sizeof(double));
+  for (int i = 0; i < M * K; ++i) {
+    a[i] = sinf(0.01f * i);
+  }
+  for (int i = 0; i < K * N; ++i) {
+    b[i] = cosf(0.003f * i) * 0.1f;
+  }
+  for (int i = 0; i < M; ++i) {
+    for (int l = 0; l < K; ++l) {
+      for (int j = 0; j < N; ++j) {
+        ref[i * N + j] += (double)a[i * K + l] * b[l * N + j];
+      }
+    }
+  }
+
+  void *a_addr = rtMalloc(sizeof(float) * M * K);
+  void *b_addr = rtMalloc(sizeof(float) * K * N);
+  void *c_addr = rtMalloc(sizeof(float) * M * N);
+  rtMemcpyH2D(a, a_addr, sizeof(float) * M * K);
+  rtMemcpyH2D(b, b_addr, sizeof(float) * K * N);
+
+  // c = a b with X_SIZE = M, Y_SIZE = K, Z_SIZE = N
+  void *args[] = {a_addr, b_addr, c_addr, (void *)M, (void *)K, (void *)N};
+  rtLaunchKernel(35, 6 * sizeof(void *), args);
+
+  rtMemcpyD2H(c_addr, c, sizeof(float) * M * N);
+
+  double sum = 0.0;
+  for (int i = 0; i < M * N; ++i) {
+    double tem = c[i] - ref[i];
+    sum += tem * tem;
+  }
+  sum /= M * N;
+  printf("GEMM.F32 MSE = %e\n", sum);
+
+  rtFree(a_addr);
+  rtFree(b_addr);
+  rtFree(c_addr);
+  free(a);
+  free(b);
+  free(c);
+  free(ref);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,64 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 256
+#define TLEN 20
+#define NTMPL 5
+
+int main() {
+  InitFPGA();
+
+  float _Complex input[LEN], tmpl[NTMPL * TLEN], output[NTMPL * LEN];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = cosf(0.05f * i * i / 8) + sinf(0.3f * i) * I;
+  }
+  for (int n = 0; n < NTMPL; ++n) {
+    for (int i = 0; i < TLEN; ++i) {
+      tmpl[n * TLEN + i] = cexpf(I * (0.01f * (n + 1) * i * i));
+    }
+  }
+
+  void *input_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *tmpl_addr = rtMalloc(sizeof(float _Complex) * NTMPL * TLEN);
+  void *spectra_addr = rtMalloc(sizeof(float _Complex) * NTMPL * LEN);
+  void *output_addr = rtMalloc(sizeof(float _Complex) * NTMPL * LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float _Complex) * LEN);
+  rtMemcpyH2D(tmpl, tmpl_addr, sizeof(float _Complex) * NTMPL * TLEN);
+
+  // template spectra, computed once
+  void *args1[] = {tmpl_addr, spectra_addr, (void *)TLEN, (void *)LEN, (void *)NTMPL};
+  rtLaunchKernel(20, 5 * sizeof(void *), args1);
+
+  // correlate the block against every template
+  void *args2[] = {input_addr, spectra_addr, output_addr, (void *)LEN, (void *)NTMPL};
+  rtLaunchKernel(21, 5 * sizeof(void *), args2);
+
+  rtMemcpyD2H(output_addr, output, sizeof(float _Complex) * NTMPL * LEN);
+
+  rtFree(input_addr);
+  rtFree(tmpl_addr);
+  rtFree(spectra_addr);
+  rtFree(output_addr);
+
+  // circular cross-correlation: y[t] = sum_i x[(t + i) % LEN] * conj(h[i])
+  float sum = 0.0;
+  for (int n = 0; n < NTMPL; ++n) {
+    for (int t = 0; t < LEN; ++t) {
+      float _Complex expect = 0;
+      for (int i = 0; i < TLEN; ++i) {
+        expect += input[(t + i) % LEN] * conjf(tmpl[n * TLEN + i]);
+      }
+      float tem = cabsf(output[n * LEN + t] - expect);
+      sum += tem * tem;
+    }
+  }
+  sum /= NTMPL * LEN;
+  printf("MF.BANK MSE = %e\n", sum);
+
+  // EXPECT_LT(sum, 0.0001);
+}
@@ -0,0 +1,73 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+// long enough to be split over the worker pool, and not a whole number of chunks
+#define LEN ((1 << 22) + 777)
+
+struct ArgF32 {
+  float value;
+  unsigned int index;
+};
+
+int main() {
+  InitFPGA();
+
+  float *input = (float *)malloc(sizeof(float) * LEN);
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = 0.1f + 0.5f * sinf(0.0007f * i) * cosf(0.013f * i);
+  }
+  // the peaks, each twice so that the first occurrence must be found
+  input[123457] = input[3000001] = 7.5f;
+  input[2222223] = input[LEN - 1] = -6.25f;
+
+  void *input_addr = rtMalloc(sizeof(float) * LEN);
+  void *sum_addr = rtMalloc(sizeof(float));
+  void *max_addr = rtMalloc(sizeof(struct ArgF32));
+  void *min_addr = rtMalloc(sizeof(struct ArgF32));
+
+  rtMemcpyH2D(input, input_addr, sizeof(float) * LEN);
+
+  void *args1[] = {input_addr, sum_addr, (void *)LEN};
+  rtLaunchKernel(29, 3 * sizeof(void *), args1);
+
+  void *args2[] = {input_addr, max_addr, (void *)LEN};
+  rtLaunchKernel(30, 3 * sizeof(void *), args2);
+
+  void *args3[] = {input_addr, min_addr, (void *)LEN};
+  rtLaunchKernel(31, 3 * sizeof(void *), args3);
+
+  float sum;
+  struct ArgF32 max, min;
+  rtMemcpyD2H(sum_addr, &sum, sizeof(float));
+  rtMemcpyD2H(max_addr, &max, sizeof(struct ArgF32));
+  rtMemcpyD2H(min_addr, &min, sizeof(struct ArgF32));
+
+  // the same reduction again must give the same bits
+  float again;
+  rtLaunchKernel(29, 3 * sizeof(void *), args1);
+  rtMemcpyD2H(sum_addr, &again, sizeof(float));
+
+  rtFree(input_addr);
+  rtFree(sum_addr);
+  rtFree(max_addr);
+  rtFree(min_addr);
+
+  double expect = 0.0;
+  for (int i = 0; i < LEN; ++i) {
+    expect += input[i];
+  }
+  double sum_err = fabs(sum - expect) / fabs(expect);
+  printf("VSUM.F32 rel err = %e, repeatable = %d\n", sum_err, sum == again);
+  printf("VARGMAX.F32 = %f at %u, VARGMIN.F32 = %f at %u\n", max.value, max.index, min.value, min.index);
+
+  free(input);
+
+  // EXPECT_LT(sum_err, 0.000001);
+  // EXPECT_EQ(sum, again);
+  // EXPECT_EQ(max.index, 123457);
+  // EXPECT_EQ(min.index, 2222223);
+}
@@ -0,0 +1,89 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define X 37
+#define Y 300
+#define Z 129
+#define SEGS 1000
+
+int main() {
+  InitFPGA();
+
+  float *input = (float *)malloc(sizeof(float) * X * Y * Z);
+  for (int i = 0; i < X * Y * Z; ++i) {
+    input[i] = sinf(0.001f * i) + 0.25f * cosf(0.37f * i);
+  }
+  // segments of 0 to 2 * Z elements covering a prefix of the input
+  unsigned int offsets[SEGS + 1];
+  offsets[0] = 0;
+  for (int s = 0; s < SEGS; ++s) {
+    offsets[s + 1] = offsets[s] + (s * 7919) % (2 * Z + 1);
+  }
+
+  void *input_addr = rtMalloc(sizeof(float) * X * Y * Z);
+  void *offsets_addr = rtMalloc(sizeof(offsets));
+  void *sum_addr = rtMalloc(sizeof(float) * X * Y * Z);
+  void *max_addr = rtMalloc(sizeof(float) * SEGS);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float) * X * Y * Z);
+  rtMemcpyH2D(offsets, offsets_addr, sizeof(offsets));
+
+  float *sum = (float *)malloc(sizeof(float) * X * Y * Z);
+  double axis_sum = 0.0;
+  for (long axis = 0; axis < 3; ++axis) {
+    void *args1[] = {input_addr, sum_addr, (void *)3, (void *)X, (void *)Y, (void *)Z, (void *)axis};
+    rtLaunchKernel(32, 7 * sizeof(void *), args1);
+    rtMemcpyD2H(sum_addr, sum, sizeof(float) * X * Y * Z);
+
+    // output index with the reduced axis removed
+    int size[3] = {X, Y, Z};
+    for (int i = 0; i < X; ++i) {
+      for (int j = 0; j < Y; ++j) {
+        for (int k = 0; k < Z; ++k) {
+          int idx[3] = {i, j, k};
+          if (idx[axis] != 0) continue;
+          double expect = 0.0;
+          for (int r = 0; r < size[axis]; ++r) {
+            idx[axis] = r;
+            expect += input[(idx[0] * Y + idx[1]) * Z + idx[2]];
+          }
+          int o = axis == 0 ? j * Z + k : axis == 1 ? i * Z + k : i * Y + j;
+          double tem = sum[o] - expect;
+          axis_sum += tem * tem;
+        }
+      }
+    }
+  }
+  axis_sum /= (double)Y * Z + X * Z + X * Y;
+
+  void *args2[] = {input_addr, offsets_addr, max_addr, (void *)SEGS};
+  rtLaunchKernel(33, 4 * sizeof(void *), args2);
+  float max[SEGS];
+  rtMemcpyD2H(max_addr, max, sizeof(float) * SEGS);
+
+  int seg_wrong = 0;
+  for (int s = 0; s < SEGS; ++s) {
+    float expect = 0.0f;
+    for (unsigned int i = offsets[s]; i < offsets[s + 1]; ++i) {
+      if (i == offsets[s] || input[i] > expect) expect = input[i];
+    }
+    seg_wrong += max[s] != expect;
+  }
+
+  rtFree(input_addr);
+  rtFree(offsets_addr);
+  rtFree(sum_addr);
+  rtFree(max_addr);
+  free(input);
+  free(sum);
+
+  printf("VSUM.AXIS.F32 MSE = %e\n", axis_sum);
+  printf("VMAX.SEG.F32 wrong segments = %d\n", seg_wrong);
+
+  // EXPECT_LT(axis_sum, 0.0001);
+  // EXPECT_EQ(seg_wrong, 0);
+}
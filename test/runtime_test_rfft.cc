@@ -0,0 +1,61 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+#define LEN 20
+#define BINS (LEN / 2 + 1)
+
+int main() {
+  InitFPGA();
+
+  float input[LEN], output[LEN];
+  float _Complex spectrum[BINS];
+  for (int i = 0; i < LEN; ++i) {
+    input[i] = cosf(0.7f * i) + 0.25f * i;
+  }
+
+  void *input_addr = rtMalloc(sizeof(float) * LEN);
+  void *rfft_output_addr = rtMalloc(sizeof(float _Complex) * BINS);
+  void *irfft_output_addr = rtMalloc(sizeof(float) * LEN);
+
+  rtMemcpyH2D(input, input_addr, sizeof(float) * LEN);
+
+  // rfft
+  void *args1[] = {input_addr, rfft_output_addr, (void *)LEN};
+  rtLaunchKernel(9, 3 * sizeof(void *), args1);
+
+  // irfft
+  void *args2[] = {rfft_output_addr, irfft_output_addr, (void *)LEN};
+  rtLaunchKernel(10, 3 * sizeof(void *), args2);
+
+  rtMemcpyD2H(rfft_output_addr, spectrum, sizeof(float _Complex) * BINS);
+  rtMemcpyD2H(irfft_output_addr, output, sizeof(float) * LEN);
+
+  rtFree(input_addr);
+  rtFree(rfft_output_addr);
+  rtFree(irfft_output_addr);
+
+  float rfft_sum = 0.0, irfft_sum = 0.0;
+  for (int k = 0; k < BINS; ++k) {
+    float _Complex expect = 0;
+    for (int i = 0; i < LEN; ++i) {
+      expect += input[i] * cexpf(-2.0f * M_PI * I * k * i / LEN);
+    }
+    float tem = cabsf(spectrum[k] - expect);
+    rfft_sum += tem * tem;
+  }
+  for (int i = 0; i < LEN; ++i) {
+    float tem = output[i] - input[i];
+    irfft_sum += tem * tem;
+  }
+  rfft_sum /= BINS;
+  irfft_sum /= LEN;
+  printf("RFFT MSE = %e\n", rfft_sum);
+  printf("IRFFT MSE = %e\n", irfft_sum);
+
+  // EXPECT_LT(rfft_sum, 0.0001);
+  // EXPECT_LT(irfft_sum, 0.0001);
+}
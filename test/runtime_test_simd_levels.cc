@@ -0,0 +1,143 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "runtime_API.h"
+
+// complex elements, not a whole number of 8- or 4-element registers
+#define LEN 4099
+#define OPS 10
+#define LEVELS 4
+
+static const char *levels[LEVELS] = {"scalar", "sse3", "avx2", "avx512"};
+static const char *ops[OPS] = {"VMUL.C32", "VMULI.C32", "VSUB.C32", "VCONJ.C32", "VABS.C32",
+                               "VMUL.C64", "VMULI.C64", "VSUB.C64", "VCONJ.C64", "VABS.C64"};
+
+static double a[2 * LEN], b[2 * LEN];
+static const double imm[2] = {0.7071067811865476, -1.4142135623730951};
+
+// Results of every op, out of place and with res == a, as double, per level.
+static double *Slot(double *out, int level, int op, int in_place) {
+  return out + (((size_t)level * OPS + op) * 2 + in_place) * 2 * LEN;
+}
+
+static void Run(int level, double *out) {
+  setenv("TAI_SIMD", levels[level], 1);
+  InitFPGA();
+
+  float af[2 * LEN], bf[2 * LEN], rf[2 * LEN];
+  static double rd[2 * LEN];
+  for (int i = 0; i < 2 * LEN; ++i) {
+    af[i] = (float)a[i];
+    bf[i] = (float)b[i];
+  }
+  const float immf[2] = {(float)imm[0], (float)imm[1]};
+
+  void *a_addr = rtMalloc(sizeof(double) * 2 * LEN);
+  void *b_addr = rtMalloc(sizeof(double) * 2 * LEN);
+  void *res_addr = rtMalloc(sizeof(double) * 2 * LEN);
+  for (int op = 0; op < OPS; ++op) {
+    int c64 = strstr(ops[op], ".C64") != NULL;
+    int binary = strncmp(ops[op], "VMUL.", 5) == 0 || strncmp(ops[op], "VSUB.", 5) == 0;
+    int abs = strncmp(ops[op], "VABS", 4) == 0;
+    size_t bytes = (c64 ? sizeof(double) : sizeof(float)) * 2 * LEN;
+    const void *imm_ptr = strncmp(ops[op], "VMULI", 5) == 0 ? (c64 ? (const void *)imm : (const void *)immf) : NULL;
+    size_t outs = abs ? LEN : 2 * LEN;
+    // |z| writes real values over complex ones, so it only runs out of place
+    for (int in_place = 0; in_place < (abs ? 1 : 2); ++in_place) {
+      rtMemcpyH2D(c64 ? (void *)a : (void *)af, a_addr, bytes);
+      rtMemcpyH2D(c64 ? (void *)b : (void *)bf, b_addr, bytes);
+      void *dst = in_place ? a_addr : res_addr;
+      void *args[] = {(void *)ops[op], dst, a_addr, binary ? b_addr : NULL, (void *)LEN, (void *)imm_ptr};
+      rtLaunchKernel(36, 6 * sizeof(void *), args);
+      double *slot = Slot(out, level, op, in_place);
+      if (c64) {
+        rtMemcpyD2H(dst, rd, sizeof(double) * outs);
+        memcpy(slot, rd, sizeof(double) * outs);
+      } else {
+        rtMemcpyD2H(dst, rf, sizeof(float) * outs);
+        for (size_t i = 0; i < outs; ++i) slot[i] = rf[i];
+      }
+    }
+  }
+  rtFree(a_addr);
+  rtFree(b_addr);
+  rtFree(res_addr);
+}
+
+// Largest difference between two runs of op in units of epsilon times the magnitude the
+// result is formed from: |a| |b| for products, |a| + |b| for differences, |a| otherwise.
+static double Deviation(double *out, int op, int level, int in_place, int ref_level, int ref_in_place) {
+  int c64 = strstr(ops[op], ".C64") != NULL;
+  int abs = strncmp(ops[op], "VABS", 4) == 0;
+  const double *x = Slot(out, level, op, in_place), *ref = Slot(out, ref_level, op, ref_in_place);
+  double worst = 0.0;
+  for (int i = 0; i < LEN; ++i) {
+    double na = hypot(a[2 * i], a[2 * i + 1]), nb = hypot(b[2 * i], b[2 * i + 1]);
+    double scale = na;
+    if (strncmp(ops[op], "VMULI", 5) == 0) scale = na * hypot(imm[0], imm[1]);
+    else if (strncmp(ops[op], "VMUL", 4) == 0) scale = na * nb;
+    else if (strncmp(ops[op], "VSUB", 4) == 0) scale = na + nb;
+    scale *= c64 ? DBL_EPSILON : FLT_EPSILON;
+    for (int k = 0; k < (abs ? 1 : 2); ++k) {
+      int j = abs ? i : 2 * i + k;
+      double d = fabs(x[j] - ref[j]) / scale;
+      if (d > worst) worst = d;
+    }
+  }
+  return worst;
+}
+
+int main() {
+  for (int i = 0; i < LEN; ++i) {
+    a[2 * i] = sin(0.01 * i) * (1 + i % 7);
+    a[2 * i + 1] = cos(0.013 * i);
+    b[2 * i] = cos(0.02 * i + 0.3);
+    b[2 * i + 1] = sin(0.005 * i) * (1 + i % 5);
+    if (i % 3 == 0) {
+      // ar br - ai bi and ar bi + ai br cancel to a few bits
+      b[2 * i] = a[2 * i + 1] * (1 + 1e-6);
+      b[2 * i + 1] = a[2 * i] * (1 - 1e-6);
+      a[2 * i + 1] = -a[2 * i + 1];
+    }
+  }
+
+  // the kernel set is fixed per process on first use, so each level runs in its own child
+  size_t bytes = sizeof(double) * LEVELS * OPS * 2 * 2 * LEN;
+  double *out = (double *)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  for (int level = 0; level < LEVELS; ++level) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      Run(level, out);
+      _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+  }
+
+  double worst = 0.0, aliased = 0.0;
+  for (int level = 0; level < LEVELS; ++level) {
+    printf("TAI_SIMD=%s:", levels[level]);
+    for (int op = 0; op < OPS; ++op) {
+      double d = Deviation(out, op, level, 0, 0, 0);
+      printf(" %s %.2f", ops[op], d);
+      worst = fmax(worst, d);
+      if (strncmp(ops[op], "VABS", 4) != 0) {
+        // res == a must give the same bits as a separate res
+        aliased = fmax(aliased, Deviation(out, op, level, 1, level, 0));
+      }
+    }
+    printf("\n");
+  }
+  printf("SIMD vs scalar max deviation = %.3f eps, in place vs out of place = %.3f eps\n", worst, aliased);
+  munmap(out, bytes);
+
+  // EXPECT_LT(worst, 2.0);
+  // EXPECT_EQ(aliased, 0.0);
+}
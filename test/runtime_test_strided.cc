@@ -0,0 +1,72 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+// columns of a row-major ROWS x COLS matrix
+#define ROWS 100000
+#define COLS 33
+
+int main() {
+  InitFPGA();
+
+  float *m = (float *)malloc(sizeof(float) * ROWS * COLS);
+  float *out = (float *)malloc(sizeof(float) * ROWS * COLS);
+  unsigned int *perm = (unsigned int *)malloc(sizeof(unsigned int) * ROWS);
+  for (int i = 0; i < ROWS * COLS; ++i) {
+    m[i] = sinf(0.01f * i) + 0.001f * (i % COLS);
+    out[i] = 0.0f;
+  }
+  for (int i = 0; i < ROWS; ++i) {
+    perm[i] = (unsigned int)(((long)i * 7919) % ROWS);
+  }
+
+  void *m_addr = rtMalloc(sizeof(float) * ROWS * COLS);
+  void *out_addr = rtMalloc(sizeof(float) * ROWS * COLS);
+  void *perm_addr = rtMalloc(sizeof(unsigned int) * ROWS);
+  rtMemcpyH2D(m, m_addr, sizeof(float) * ROWS * COLS);
+  rtMemcpyH2D(out, out_addr, sizeof(float) * ROWS * COLS);
+  rtMemcpyH2D(perm, perm_addr, sizeof(unsigned int) * ROWS);
+
+  // column 2 of out = column 5 + column 7, read and written in place
+  void *args1[] = {(char *)m_addr + 5 * sizeof(float), (char *)m_addr + 7 * sizeof(float),
+                   (char *)out_addr + 2 * sizeof(float), (void *)ROWS,
+                   (void *)COLS, (void *)COLS, (void *)COLS, 0, 0, 0};
+  rtLaunchKernel(34, 10 * sizeof(void *), args1);
+  rtMemcpyD2H(out_addr, out, sizeof(float) * ROWS * COLS);
+
+  double strided_sum = 0.0;
+  for (int i = 0; i < ROWS; ++i) {
+    double tem = out[i * COLS + 2] - (m[i * COLS + 5] + m[i * COLS + 7]);
+    strided_sum += tem * tem;
+  }
+  strided_sum /= ROWS;
+
+  // out[perm[i]] = m[perm[i]] + column 0 of m, gathered and scattered through perm
+  void *args2[] = {m_addr, m_addr, out_addr, (void *)ROWS,
+                   0, (void *)COLS, 0, perm_addr, 0, perm_addr};
+  rtLaunchKernel(34, 10 * sizeof(void *), args2);
+
+  rtMemcpyD2H(out_addr, out, sizeof(float) * ROWS * COLS);
+
+  double gather_sum = 0.0;
+  for (int i = 0; i < ROWS; ++i) {
+    double tem = out[perm[i]] - (m[perm[i]] + m[i * COLS]);
+    gather_sum += tem * tem;
+  }
+  gather_sum /= ROWS;
+  printf("VADD.F32 strided MSE = %e\n", strided_sum);
+  printf("VADD.F32 gather/scatter MSE = %e\n", gather_sum);
+
+  rtFree(m_addr);
+  rtFree(out_addr);
+  rtFree(perm_addr);
+  free(m);
+  free(out);
+  free(perm);
+
+  // EXPECT_LT(strided_sum, 0.0001);
+  // EXPECT_LT(gather_sum, 0.0001);
+}
@@ -0,0 +1,68 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <math.h>
+
+#include "runtime_API.h"
+
+// long enough to be split over the worker pool, and not a whole number of chunks
+#define LEN ((1 << 21) + 1000)
+
+int main() {
+  InitFPGA();
+
+  float _Complex *a = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  float _Complex *c = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  float _Complex *product = (float _Complex *)malloc(sizeof(float _Complex) * LEN);
+  double *level = (double *)malloc(sizeof(double) * LEN);
+  for (int i = 0; i < LEN; ++i) {
+    a[i] = (1.0f + 0.5f * cosf(0.001f * i)) + 0.3f * sinf(0.002f * i) * I;
+    c[i] = 0.7f * cosf(0.0003f * i) + (0.2f + 0.1f * (float)i / LEN) * I;
+  }
+
+  void *a_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *c_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *product_addr = rtMalloc(sizeof(float _Complex) * LEN);
+  void *level_addr = rtMalloc(sizeof(double) * LEN);
+
+  rtMemcpyH2D(a, a_addr, sizeof(float _Complex) * LEN);
+  rtMemcpyH2D(c, c_addr, sizeof(float _Complex) * LEN);
+
+  // a single instruction
+  void *args1[] = {a_addr, c_addr, product_addr, (void *)LEN};
+  rtLaunchKernel(4, 4 * sizeof(void *), args1);
+
+  // a fused chain
+  void *args2[] = {a_addr, c_addr, level_addr, (void *)LEN};
+  rtLaunchKernel(26, 4 * sizeof(void *), args2);
+
+  rtMemcpyD2H(product_addr, product, sizeof(float _Complex) * LEN);
+  rtMemcpyD2H(level_addr, level, sizeof(double) * LEN);
+
+  rtFree(a_addr);
+  rtFree(c_addr);
+  rtFree(product_addr);
+  rtFree(level_addr);
+
+  double mul_sum = 0.0, fused_sum = 0.0;
+  for (int i = 0; i < LEN; ++i) {
+    float _Complex expect = a[i] * c[i];
+    double tem = cabsf(product[i] - expect);
+    mul_sum += tem * tem;
+    tem = level[i] - log10(cabs(a[i] * c[i]));
+    fused_sum += tem * tem;
+  }
+  mul_sum /= LEN;
+  fused_sum /= LEN;
+  printf("VMUL.C32 MSE = %e\n", mul_sum);
+  printf("FUSED MSE = %e\n", fused_sum);
+
+  free(a);
+  free(c);
+  free(product);
+  free(level);
+
+  // EXPECT_LT(mul_sum, 0.0001);
+  // EXPECT_LT(fused_sum, 0.0001);
+}
@@ -0,0 +1,172 @@
+// #include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "runtime_API.h"
+
+// every size is long enough to be split over the worker pool
+#define RLEN ((1 << 20) + 777)
+#define X 37
+#define Y 300
+#define Z 129
+#define SEGS 1000
+#define VLEN ((1 << 18) + 123)
+#define ULEN 100003
+#define TAPS 333
+#define DECIM 4
+#define ROWS 256
+#define COLS 384
+#define GEMM_M 333
+#define GEMM_K 517
+#define GEMM_N 271
+#define FFT_LEN (1 << 17)
+#define KERNELS 10
+
+static const char *kernels[KERNELS] = {"VSUM.F32", "VARGMAX.F32", "VSUM.AXIS.F32", "VMAX.SEG.F32", "VMUL.C32",
+                                       "FIR.DECIM", "CONV (FFT)", "FFT2D", "GEMM.F32", "FFT"};
+
+// Per run, the bytes of each kernel's output one after the other.
+struct Results {
+  size_t offset[KERNELS + 1];
+  unsigned char data[8 << 20];
+};
+
+static float *Real(size_t n, float f) {
+  float *x = (float *)malloc(sizeof(float) * n);
+  for (size_t i = 0; i < n; ++i) x[i] = sinf(f * i) + 0.25f * cosf(0.37f * i);
+  return x;
+}
+
+static float _Complex *Cplx(size_t n, float f) {
+  float _Complex *x = (float _Complex *)malloc(sizeof(float _Complex) * n);
+  for (size_t i = 0; i < n; ++i) x[i] = sinf(f * i) + cosf(0.37f * i) * I;
+  return x;
+}
+
+// Copy n bytes of device memory at addr to the next output of r.
+static void Put(struct Results *r, int k, void *addr, size_t n) {
+  rtMemcpyD2H(addr, r->data + r->offset[k], n);
+  r->offset[k + 1] = r->offset[k] + n;
+}
+
+static void Run(const char *workers, struct Results *r) {
+  setenv("TAI_WORKERS", workers, 1);
+  InitFPGA();
+  r->offset[0] = 0;
+
+  float *red = Real(RLEN, 0.0007f);
+  void *red_addr = rtMalloc(sizeof(float) * RLEN);
+  void *out_addr = rtMalloc(sizeof(float _Complex) * VLEN);
+  rtMemcpyH2D(red, red_addr, sizeof(float) * RLEN);
+
+  void *sum_args[] = {red_addr, out_addr, (void *)RLEN};
+  rtLaunchKernel(29, 3 * sizeof(void *), sum_args);
+  Put(r, 0, out_addr, sizeof(float));
+  rtLaunchKernel(30, 3 * sizeof(void *), sum_args);
+  Put(r, 1, out_addr, 8);
+
+  void *axis_args[] = {red_addr, out_addr, (void *)3, (void *)X, (void *)Y, (void *)Z, (void *)1};
+  rtLaunchKernel(32, 7 * sizeof(void *), axis_args);
+  Put(r, 2, out_addr, sizeof(float) * X * Z);
+
+  unsigned int offsets[SEGS + 1];
+  offsets[0] = 0;
+  for (int s = 0; s < SEGS; ++s) offsets[s + 1] = offsets[s] + (s * 7919) % (2 * Z + 1);
+  void *offsets_addr = rtMalloc(sizeof(offsets));
+  rtMemcpyH2D(offsets, offsets_addr, sizeof(offsets));
+  void *seg_args[] = {red_addr, offsets_addr, out_addr, (void *)SEGS};
+  rtLaunchKernel(33, 4 * sizeof(void *), seg_args);
+  Put(r, 3, out_addr, sizeof(float) * SEGS);
+
+  float _Complex *a = Cplx(VLEN, 0.001f), *c = Cplx(VLEN, 0.0003f);
+  void *a_addr = rtMalloc(sizeof(float _Complex) * VLEN);
+  void *c_addr = rtMalloc(sizeof(float _Complex) * VLEN);
+  rtMemcpyH2D(a, a_addr, sizeof(float _Complex) * VLEN);
+  rtMemcpyH2D(c, c_addr, sizeof(float _Complex) * VLEN);
+  void *mul_args[] = {a_addr, c_addr, out_addr, (void *)VLEN};
+  rtLaunchKernel(4, 4 * sizeof(void *), mul_args);
+  Put(r, 4, out_addr, sizeof(float _Complex) * VLEN);
+
+  float *taps = Real(TAPS, 0.2f);
+  void *taps_addr = rtMalloc(sizeof(float) * TAPS);
+  rtMemcpyH2D(taps, taps_addr, sizeof(float) * TAPS);
+  void *decim_args[] = {red_addr, taps_addr, out_addr, (void *)ULEN, (void *)TAPS, (void *)(DECIM - 1)};
+  rtLaunchKernel(13, 6 * sizeof(void *), decim_args);
+  Put(r, 5, out_addr, sizeof(float) * ((ULEN + TAPS - 2) / DECIM + 1));
+  void *conv_args[] = {red_addr, taps_addr, out_addr, (void *)ULEN, (void *)TAPS, (void *)TAPS};
+  rtLaunchKernel(37, 6 * sizeof(void *), conv_args);
+  Put(r, 6, out_addr, sizeof(float) * (ULEN + TAPS - 1));
+
+  void *fft2d_args[] = {a_addr, out_addr, (void *)ROWS, (void *)COLS};
+  rtLaunchKernel(15, 4 * sizeof(void *), fft2d_args);
+  Put(r, 7, out_addr, sizeof(float _Complex) * ROWS * COLS);
+
+  void *gemm_args[] = {red_addr, red_addr, out_addr, (void *)GEMM_M, (void *)GEMM_K, (void *)GEMM_N};
+  rtLaunchKernel(35, 6 * sizeof(void *), gemm_args);
+  Put(r, 8, out_addr, sizeof(float) * GEMM_M * GEMM_N);
+
+  void *fft_args[] = {a_addr, out_addr, (void *)FFT_LEN};
+  rtLaunchKernel(1, 3 * sizeof(void *), fft_args);
+  Put(r, 9, out_addr, sizeof(float _Complex) * FFT_LEN);
+
+  rtFree(red_addr);
+  rtFree(out_addr);
+  rtFree(offsets_addr);
+  rtFree(a_addr);
+  rtFree(c_addr);
+  rtFree(taps_addr);
+  free(red);
+  free(a);
+  free(c);
+  free(taps);
+}
+
+int main() {
+  // the pool is sized once per process, so each worker count runs in its own child
+  const char *workers[2] = {"0", "3"};
+  struct Results *r = (struct Results *)mmap(NULL, 2 * sizeof(struct Results), PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  for (int w = 0; w < 2; ++w) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      Run(workers[w], &r[w]);
+      _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+  }
+
+  // Everything but FFT splits the same work the same way with and without workers and must
+  // match bit for bit. A long FFT takes the four-step path only with workers.
+  int mismatched = 0;
+  double fft_err = 0.0, fft_norm = 0.0;
+  for (int k = 0; k < KERNELS; ++k) {
+    size_t n = r[0].offset[k + 1] - r[0].offset[k];
+    const unsigned char *x = r[0].data + r[0].offset[k], *y = r[1].data + r[1].offset[k];
+    if (k == 9) {
+      const float _Complex *fx = (const float _Complex *)x, *fy = (const float _Complex *)y;
+      for (int i = 0; i < FFT_LEN; ++i) {
+        fft_err += cabsf(fx[i] - fy[i]) * cabsf(fx[i] - fy[i]);
+        fft_norm += cabsf(fx[i]) * cabsf(fx[i]);
+      }
+      continue;
+    }
+    int same = n == r[1].offset[k + 1] - r[1].offset[k] && memcmp(x, y, n) == 0;
+    if (!same) {
+      printf("%s differs between TAI_WORKERS=0 and 3\n", kernels[k]);
+      ++mismatched;
+    }
+  }
+  fft_err = sqrt(fft_err / fft_norm);
+  printf("TAI_WORKERS=0 vs 3: %d of %d kernels differ, FFT relative RMS = %e\n", mismatched, KERNELS - 1, fft_err);
+  munmap(r, 2 * sizeof(struct Results));
+
+  // EXPECT_EQ(mismatched, 0);
+  // EXPECT_LT(fft_err, 1e-6);
+}